@@ -6,19 +6,34 @@
 #include <string.h>
 #include <math.h>
 
-#include "pico/stdlib.h"
-#include "pico/binary_info.h"
-
-#include "hardware/gpio.h"
-#include "hardware/adc.h"
-#include "hardware/i2c.h"
-#include "hardware/clocks.h"
-#include "hardware/pwm.h"
+#include "hal.h"
 
 #include "ssd1306_font.h"
 #include "images.h"
 #include "display.h"
 #include "musics.h"
+#include "melody.h"
+#include "mic_capture.h"
+#include "weighting.h"
+#include "dc_block.h"
+#include "bands.h"
+#include "ipc.h"
+#include "input.h"
+#include "alarm.h"
+#include "power.h"
+#include "sched.h"
+#include "pages.h"
+#include "gesture.h"
+#include "dose.h"
+#include "level_db.h"
+#include "time_weighting.h"
+#include "stats.h"
+#include "envelope.h"
+#include "flash_log.h"
+#include "telemetry.h"
+#ifdef SIMIS_BENCHMARK
+#include "bench.h"
+#endif
 
 // Pino e canal do microfone e joystick no ADC.
 const uint8_t ADC_VERT = 0;
@@ -39,45 +54,160 @@ const uint Y_PIN = 26;       // Pino da Posição Y do Joystick
 const uint X_PIN = 27;       // Pino da Posição X do Joystick
 const uint SEL_PIN = 22;     // Pino do Botão do Joystick
 
-// Interrupções dos Botões
-volatile bool btn_a_pressed = false;
-volatile bool btn_b_pressed = false;
-volatile bool sel_pressed = false;
-volatile uint64_t last_interrupt_time = 0;
+// Bordas dos botões, da interrupção para a tarefa de entrada (input.h)
+InputQueue buttons;
 
-uint8_t saved_page = 3; // Página salva pelo botão B
-uint64_t last_time; // Último tempo de leitura do ADC
+uint8_t saved_page = 3; // Tela inicial: escolhida pelo botão A, fixada pelo B ou segurando o joystick
+uint8_t nav_page = 0;   // Página escolhida pelo joystick (0 = a tela inicial)
+PageView ui_view;       // Página do quadro atual e dados que mudaram (pages.h)
 
-uint8_t buf[SSD1306_BUF_LEN]; // Buffer para renderização do display
+#define PAGE_BANDS 6      // Tela extra do analisador de bandas (botão A)
+#define PAGE_STATS 7      // Tela extra de estatísticas (botão A)
+bool bands_octave_view = true; // Bandas de oitava (true) ou de terço de oitava (false)
+uint8_t graph_zoom = 0;        // Nível do histórico (envelope.h) mostrado no gráfico
 
-// Variáveis globais para acúmulo de tempo (em segundos)
-float elapsed85 = 0.0f;
-float elapsed88 = 0.0f;
-float elapsed91 = 0.0f;
-float elapsed94 = 0.0f;
-float elapsed97 = 0.0f;
+uint8_t buf[SSD1306_BUF_LEN]; // Buffer para renderização do display
 
 // Limite de volume máximo para alarme imediato (em dB)
 #define MAX_VOLUME_THRESHOLD 100.0f
 
-float adc_baseline = 2047.5f; // Valor inicial médio do ADC (12 bits)
-
-float safe_values[5] = {0}; // Array de tempos seguros para cada faixa (85,88,91,94,97 dB)
+// Calibração de get_intensity() em centi-dB para energia em contagens Q8 (Q16 ao
+// quadrado): 100 * (20 log10(3.3 / 0.05) - 10 log10(65536))
+#define MIC_LEVEL_OFFSET_CDB (-1177)
+
+// Maior pico mensurável (centi-dB): meia escala do ADC, 2048 contagens em Q8, na
+// calibração acima: 100 * 20 log10(2048 * 256) + MIC_LEVEL_OFFSET_CDB = 102.6 dB
+#define MIC_PEAK_FULL_SCALE_CDB (11439 + MIC_LEVEL_OFFSET_CDB)
+
+// Limite do pico ponderado em C para alarme imediato (centi-dB): 140 dB(C) é o valor
+// limite da Diretiva 2003/10/CE e da NR-15; 13500 dá o valor de ação inferior. Só é
+// atingível com um microfone calibrado para isso (MIC_PEAK_FULL_SCALE_CDB acima do
+// limite); com o atual o ADC satura antes, e a saturação é indicada à parte.
+#ifndef PEAK_ALARM_CDB
+#define PEAK_ALARM_CDB 14000
+#endif
+
+// Saturação do ADC: uma amostra a menos de MIC_CLIP_MARGIN contagens de 0 ou de 4095
+// marca o bloco como fora da faixa (o nível real é maior que o medido). O núcleo 0
+// mostra a indicação por OVER_RANGE_HOLD_US depois do último bloco saturado e conta
+// cada episódio em overRangeCount, sem confundir com o limite de pico.
+#define MIC_CLIP_MARGIN 16
+#define OVER_RANGE_HOLD_US 2000000
+
+// Acúmulo das amostras do microfone entre duas chamadas de mic_power() (núcleo 1)
+DcBlocker mic_dc;                    // Polarização do microfone, acompanhada continuamente
+uint64_t mic_energy = 0;             // Soma dos quadrados das amostras ponderadas (contagens Q8)
+uint32_t mic_sample_count = 0;       // Amostras acumuladas
+bool mic_clipped = false;            // Alguma amostra saturada desde o último bloco de medição
+
+WeightingFilter mic_weighting;        // Ponderação em frequência aplicada ao microfone
+Weighting mic_weighting_type = WEIGHT_A;
+WeightingFilter mic_peak_weighting;   // Curva C do detector de pico (quando a ponderação não é C)
+TimeWeighting mic_tw;                 // Detectores F, S, I e de pico (time_weighting.h)
+
+DoseCriterionId dose_criterion = DOSE_NIOSH; // Critério mostrado e usado no alarme de dose
 
 // Contadores de alarmes
 int alarmCountSafe = 0;      // Alarmes disparados por exposição excessiva
 int alarmCountMaxVolume = 0; // Alarmes disparados por volume máximo
+int overRangeCount = 0;      // Episódios de saturação do ADC (não são alarmes)
+bool over_range = false;     // Saturação recente: o nível mostrado é um mínimo
 
 // Último motivo de alarme (para exibição)
 char lastAlarmReason[30] = {0};
 
-// Variável de controle para evitar alarmes repetidos enquanto a condição persistir
-bool alarmActive = false;
+// Estado do alarme (alarm.h); evita alarmes repetidos enquanto a condição persistir
+AlarmState alarm_state = ALARM_IDLE;
+bool alarm_is_dose = false;   // O alarme disparado é o de dose de 100% (não o de volume)
+uint32_t peak_alarm_seen = 0; // Último meas.peak_alarm_blocks tratado (núcleo 0)
+uint32_t over_range_seen = 0; // Último meas.over_range_blocks tratado (núcleo 0)
+uint64_t over_range_until_us = 0;
+
+// Modo de baixo consumo (power.h), decidido pelo núcleo 0; o host liga e desliga
+// pela telemetria ('L' e 'N')
+#ifndef POWER_LOW_DEFAULT
+#define POWER_LOW_DEFAULT true
+#endif
+PowerState power;
 
 #define NUM_READINGS 10
-float mic_readings[NUM_READINGS] = {0}; // Buffer para as 10 últimas leituras
-int reading_index = 0;                  // Índice do próximo elemento a ser escrito
-float max_peak = 0.0f;
+
+// Divisão de trabalho entre os núcleos:
+// - núcleo 1: captura, ponderação, nível, bandas e tempo de exposição (acquisition_step)
+// - núcleo 0: joystick, botões, alarmes e display (tarefas de sched.h)
+// O núcleo 1 publica um retrato completo (Measurement) a cada bloco de medição por
+// um seqlock; o núcleo 0 envia comandos pela fila SPSC core1_cmds. Nenhum dos dois
+// espera pelo outro. O contrato de ordem de memória está em ipc.h.
+#define ACQ_BLOCK_SAMPLES (MIC_SAMPLE_RATE_HZ / 10) // Um bloco de medição a cada 100 ms
+
+typedef struct
+{
+  float intensity;                   // Nível do último bloco (dB)
+  float mic_readings[NUM_READINGS];  // Buffer para as 10 últimas leituras
+  int reading_index;                 // Índice do próximo elemento a ser escrito
+  float recent_peak;                 // Maior das últimas leituras (dB)
+  float recent_leq;                  // Média de energia das últimas leituras (dB)
+  StatsSummary stats;                // Leq, Lmax, Lmin e percentis desde o último reset
+  uint64_t stats_duration_samples;   // Duração da janela das estatísticas
+  uint32_t minute_count;             // Minutos completos medidos (para o histórico)
+  int32_t minute_leq_cdb;            // Leq e maior nível do último minuto completo
+  int32_t minute_lmax_cdb;
+  uint32_t blocks;                   // Blocos de medição concluídos
+  int32_t level_cdb;                 // intensity em centi-dB
+  uint16_t capture_us;               // Maior tempo de cada etapa desde o último bloco
+  uint16_t bands_us;
+  uint16_t level_us;
+  DoseState dose;                    // Dose de ruído de cada critério
+  uint32_t exposure_epoch;           // Quantas vezes a exposição foi zerada
+  Weighting weighting;               // Ponderação em uso
+  float third_ms[BANDS_THIRD_COUNT]; // Média quadrática por banda (contagens^2)
+  float octave_ms[BANDS_OCTAVE_COUNT];
+  MicCaptureStats capture;
+  int32_t mic_baseline_q4;           // Polarização estimada do microfone (contagens Q4)
+  int32_t lf_cdb;                    // Níveis F, S e I no fim do bloco, na ponderação em uso
+  int32_t ls_cdb;
+  int32_t li_cdb;
+  int32_t lfmax_cdb;                 // Maior nível F do bloco
+  int32_t lcpeak_cdb;                // Maior pico ponderado em C do bloco
+  int32_t lfmax_stats_cdb;           // Maiores F e pico desde o último reset das estatísticas
+  int32_t lcpeak_stats_cdb;
+  uint32_t peak_alarm_blocks;        // Blocos com lcpeak_cdb >= PEAK_ALARM_CDB (só cresce)
+  uint32_t over_range_blocks;        // Blocos com o ADC saturado (só cresce)
+  uint16_t core1_load_permille;      // Tempo ocupado do núcleo 1 no último bloco (milésimos)
+} Measurement;
+
+// Comandos do núcleo 0 para o núcleo 1: (comando << 8) | argumento
+enum
+{
+  CMD_RESET_EXPOSURE = 1, // Zera a dose
+  CMD_SET_WEIGHTING,      // Argumento: Weighting
+  CMD_ADD_EXPOSURE_97,    // Injeção de teste: argumento em minutos a 97 dB
+  CMD_RESET_STATS,        // Zera as estatísticas
+  CMD_SET_BANDS,          // Argumento: 1 liga a análise de bandas, 0 desliga
+  CMD_RESUME_EXPOSURE,    // Soma à dose a exposição retomada (resume_dose)
+};
+
+SeqLock meas_lock;        // Protege meas_shared
+Measurement meas_shared;  // Escrito só pelo núcleo 1
+SpscQueue core1_cmds;     // Produtor: núcleo 0; consumidor: núcleo 1
+
+Measurement acq = {};     // Estado de trabalho do núcleo 1
+StatsState acq_stats;     // Estatísticas desde o último reset (núcleo 1)
+EnvelopeStore env_acq;    // Histórico em várias resoluções (núcleo 1)
+SeqLock env_lock;         // Protege env_shared
+EnvTier env_shared[ENV_TIERS]; // Escrito só pelo núcleo 1, um nível quando ele fecha uma coluna
+uint32_t core1_busy_us = 0;    // Tempo ocupado desde o último bloco (núcleo 1)
+bool bands_enabled = false;    // Análise de bandas pedida pela página visível (núcleo 1)
+uint64_t minute_energy = 0;    // Acúmulo do minuto em andamento (núcleo 1)
+uint64_t minute_samples = 0;
+int32_t minute_max_cdb = 0;
+uint64_t recent_energy[NUM_READINGS];  // Energia e amostras de cada leitura em
+uint32_t recent_samples[NUM_READINGS]; // mic_readings, para o Leq recente (núcleo 1)
+Measurement meas = {};    // Último retrato lido pelo núcleo 0
+
+uint32_t exposure_epoch_requested = 0; // Zeramentos pedidos pelo núcleo 0
+double resume_dose[DOSE_CRITERIA_COUNT];  // Exposição da jornada interrompida, escrita
+uint64_t resume_duration_samples = 0;     // pelo núcleo 0 antes de CMD_RESUME_EXPOSURE
 
 // Estrutura para armazenar as notas musicais
 typedef struct
@@ -102,25 +232,18 @@ typedef struct
   const char *warning;
 } ExposureLimit;
 
-// Função de tratamento de interrupção
+// Função de tratamento de interrupção: só registra a borda (o debounce é por pino).
+// Com as duas bordas pendentes (trepidação mais rápida que a interrupção) vale o
+// nível atual do pino.
 void gpio_callback(uint gpio, uint32_t events)
 {
-  // Debounce de 50ms
-  if (time_us_64() - last_interrupt_time > 50000)
-  {
-    last_interrupt_time = time_us_64();
-
-    if (gpio == BTNA)
-      btn_a_pressed = true;
-    if (gpio == BTNB)
-      btn_b_pressed = true;
-    if (gpio == SEL_PIN)
-      sel_pressed = true;
-  }
+  bool fall = events & HAL_GPIO_EDGE_FALL, rise = events & HAL_GPIO_EDGE_RISE;
+  bool pressed = fall && rise ? !hal_gpio_get(gpio) : fall;
+  input_isr(&buttons, (uint8_t)gpio, pressed, hal_time_us_32());
 }
 
-// Função para exibir texto no display
-void show_text(const char *text[], int num_lines, uint8_t *buf, struct render_area *frame_area, bool invert, uint16_t time)
+// Escreve as linhas de texto no buffer, sem enviar ao display
+void write_text(const char *text[], int num_lines, uint8_t *buf)
 {
   int y = 0;
   for (int i = 0; i < num_lines; i++)
@@ -128,58 +251,26 @@ void show_text(const char *text[], int num_lines, uint8_t *buf, struct render_ar
     WriteString(buf, 5, y, (char *)text[i]); // Escreve a string no buffer
     y += 8;                                  // Avança 8 pixels para a próxima linha
   }
+}
+
+// Função para exibir texto no display
+void show_text(const char *text[], int num_lines, uint8_t *buf, struct render_area *frame_area, bool invert, uint16_t time)
+{
+  write_text(text, num_lines, buf);
   render(buf, frame_area); // Renderiza o buffer no display
   // sleep_ms(time);
   return;
 }
 
-// Toca uma nota com a frequência e duração especificadas
+// Toca uma nota com a frequência e duração especificadas (bloqueante; usada só no
+// teste de frequência, as melodias usam o sequenciador de melody.h)
 void play_tone(uint pin, uint frequency, uint duration_ms)
 {
-  uint slice_num = pwm_gpio_to_slice_num(pin);
-  uint32_t clock_freq = clock_get_hz(clk_sys);
-  uint32_t top = clock_freq / frequency - 1;
-
-  // Equalização baseada na frequência
-  float eq_factor;
-  if (frequency < 3000)
-  {
-    eq_factor = 0.1; // +6dB em graves
-  }
-  else if (frequency < 4000)
-  {
-    eq_factor = 0.1; // 0dB
-  }
-  else
-  {
-    eq_factor = 0.1; // -12dB em agudos
-  }
-
-  uint32_t level = (uint32_t)(top * eq_factor * 00.1);
-
-  pwm_set_wrap(slice_num, top);
-  pwm_set_gpio_level(pin, level); // 50% de duty cycle
-
-  sleep_ms(duration_ms);
-
-  pwm_set_gpio_level(pin, 0); // Desliga o som após a duração
-  sleep_ms(50);               // Pausa entre notas
-}
+  hal_buzzer_tone(pin, frequency);
+  hal_sleep_ms(duration_ms);
 
-// Função principal para tocar a música
-void play_music(uint pin, const Note notes[], int num_notes)
-{
-  for (int i = 0; i < num_notes; i++)
-  {
-    if (notes[i].frequency == 0)
-    {
-      sleep_ms(notes[i].duration);
-    }
-    else
-    {
-      play_tone(pin, notes[i].frequency, notes[i].duration);
-    }
-  }
+  hal_buzzer_tone(pin, 0); // Desliga o som após a duração
+  hal_sleep_ms(MELODY_NOTE_GAP_MS); // Pausa entre notas
 }
 
 void triggerAlarm(const char *reason)
@@ -202,39 +293,105 @@ void triggerAlarm(const char *reason)
       " e  prosseguir "};
 
   const int num_lines = sizeof(text) / sizeof(text[0]);
+  memset(buf, 0, SSD1306_BUF_LEN);
   show_text(text, num_lines, buf, &frame_area, true, 1000);
 
-  gpio_put(LED_R, 1);
-  gpio_put(LED_G, 0);
-  gpio_put(LED_B, 0);
+  hal_gpio_put(LED_R, 1);
+  hal_gpio_put(LED_G, 0);
+  hal_gpio_put(LED_B, 0);
+
+  // A melodia toca em laço, em segundo plano, até o alarme ser reconhecido
+  if (!melody_is_playing())
+    melody_start(BUZZB, alarm_melody, sizeof(alarm_melody) / sizeof(alarm_melody[0]), true);
+}
+
+// Callback de bloco da captura: pondera cada amostra, acumula a energia e alimenta
+// os detectores F/S/I e o pico em C
+void mic_block_ready(const uint16_t *samples, uint32_t count)
+{
+  uint64_t energy = 0;
+  bool peak_is_main = mic_weighting_type == WEIGHT_C; // Evita filtrar duas vezes
+  bool bands_on = bands_enabled;
+  uint16_t lo = 0xFFFF, hi = 0;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    lo = samples[i] < lo ? samples[i] : lo;
+    hi = samples[i] > hi ? samples[i] : hi;
+    int32_t d = dc_block_run(&mic_dc, samples[i]); // Contagens em Q4, sem DC
+    if (bands_on)
+      bands_push((int16_t)(d >> 4));
+    int32_t x = d << (WEIGHTING_INPUT_SHIFT - 4);
+    int32_t y = weighting_run(&mic_weighting, x) >> (WEIGHTING_INPUT_SHIFT - 8); // Contagens em Q8
+    uint64_t e = (uint64_t)((int64_t)y * y);
+    energy += e;
+    tw_run(&mic_tw, e);
+    tw_peak(&mic_tw, peak_is_main ? y : weighting_run(&mic_peak_weighting, x) >> (WEIGHTING_INPUT_SHIFT - 8));
+  }
+  mic_energy += energy;
+  mic_sample_count += count;
+  if (lo < MIC_CLIP_MARGIN || hi > 4095 - MIC_CLIP_MARGIN)
+    mic_clipped = true;
+}
+
+// Aplica uma ponderação em frequência e reinicia o acúmulo (núcleo 1)
+void set_weighting(Weighting type)
+{
+  mic_weighting_type = type;
+  weighting_init(&mic_weighting, mic_weighting_type, MIC_SAMPLE_RATE_HZ);
+  weighting_init(&mic_peak_weighting, WEIGHT_C, MIC_SAMPLE_RATE_HZ);
+  bands_reset();
+  stats_reset(&acq_stats); // Não mistura níveis de ponderações diferentes
+  acq.stats_duration_samples = 0;
+  acq.lfmax_stats_cdb = 0;
+  acq.lcpeak_stats_cdb = 0;
+  mic_energy = 0;
+  mic_sample_count = 0;
+}
 
-  play_music(BUZZB, alarm_melody, sizeof(alarm_melody) / sizeof(alarm_melody[0]));
-  gpio_put(LED_R, 0);
-  sleep_ms(500);
+// Envia um comando ao núcleo 1; se a fila estiver cheia o comando é descartado
+bool core1_send(uint8_t cmd, uint8_t arg)
+{
+  return spsc_push(&core1_cmds, ((uint32_t)cmd << 8) | arg);
 }
 
-// Função para ler o valor do ADC
-uint32_t read_adc(uint8_t adc_channel) {
-  adc_select_input(adc_channel);
-  return adc_read();
+// Pede a próxima ponderação (A -> C -> Z) a partir da que está em uso (núcleo 0)
+void cycle_weighting()
+{
+  core1_send(CMD_SET_WEIGHTING, (meas.weighting + 1) % WEIGHT_COUNT);
 }
 
 // Calcula a potência média das leituras do ADC. (Valor RMS)
+// Considera todas as amostras entregues por mic_capture_service() desde a chamada
+// anterior, sem lacunas, já ponderadas em frequência.
 float mic_power()
 {
-  float avg = 0.f;
-  uint32_t sound = 0;
-  uint8_t medidas = 50;
+  if (mic_sample_count == 0)
+    return 0.f;
 
-  for (uint i = 0; i < medidas; ++i) {
-    sound = read_adc(ADC_MIC);
-    avg += abs(sound - adc_baseline); // Subtrai a baseline calibrada
-  }
+  float rms = sqrtf((float)mic_energy / mic_sample_count) / 256.0f;
+  mic_energy = 0;
+  mic_sample_count = 0;
+  return rms;
+}
 
-  return avg / medidas;
+// Nível em centi-dB das amostras acumuladas desde a chamada anterior, só com
+// inteiros (level_db.h); equivale a get_intensity(mic_power()) com erro < 0.01 dB
+int32_t mic_level_cdb()
+{
+  int32_t cdb = level_cdb_from_energy(mic_energy, mic_sample_count, MIC_LEVEL_OFFSET_CDB);
+  mic_energy = 0;
+  mic_sample_count = 0;
+  return cdb;
 }
 
-// Calcula a intensidade sonora em dB a partir da tensão lida no ADC
+// Nível em dB de uma média quadrática em contagens^2 (bandas)
+float mean_square_db(float ms)
+{
+  return level_cdb_from_energy((uint64_t)(ms * 65536.0f), 1, MIC_LEVEL_OFFSET_CDB) * 0.01f;
+}
+
+// Calcula a intensidade sonora em dB a partir da tensão lida no ADC (caminho em
+// ponto flutuante, mantido como referência para o benchmark)
 float get_intensity(float v)
 {
   if (v == 0)
@@ -248,127 +405,59 @@ void find_led(float db)
 {
   if (db <= 70.0f)
   {
-    gpio_put(LED_R, 0);
-    gpio_put(LED_G, 1);
-    gpio_put(LED_B, 0);
+    hal_gpio_put(LED_R, 0);
+    hal_gpio_put(LED_G, 1);
+    hal_gpio_put(LED_B, 0);
   }
   else if (db <= 85.0f)
   {
-    gpio_put(LED_R, 1);
-    gpio_put(LED_G, 1);
-    gpio_put(LED_B, 0);
+    hal_gpio_put(LED_R, 1);
+    hal_gpio_put(LED_G, 1);
+    hal_gpio_put(LED_B, 0);
   }
   else
   {
-    gpio_put(LED_R, 1);
-    gpio_put(LED_G, 0);
-    gpio_put(LED_B, 0);
+    hal_gpio_put(LED_R, 1);
+    hal_gpio_put(LED_G, 0);
+    hal_gpio_put(LED_B, 0);
   }
   return;
 }
 
-// Inicializa o PWM no pino do buzzer
-void pwm_init_buzzer(uint pin)
-{
-  gpio_set_function(pin, GPIO_FUNC_PWM);
-  uint slice_num = pwm_gpio_to_slice_num(pin);
-  pwm_config config = pwm_get_default_config();
-  pwm_config_set_clkdiv(&config, 4.0f); // Ajusta divisor de clock
-  pwm_init(slice_num, &config, true);
-  pwm_set_gpio_level(pin, 0); // Desliga o PWM inicialmente
-}
-
 // Função para configurar os pinos do LED_R e dos botões
 void config_pins()
 {
-  stdio_init_all(); // Inicializa a comunicação serial (para depuração)
-
-  gpio_init(LED_R); // Inicializa o pino do LED_R
-  gpio_init(LED_G); // Inicializa o pino do LED_G
-  gpio_init(LED_B); // Inicializa o pino do LED_B
-  gpio_set_irq_enabled_with_callback(BTNA, GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
-  gpio_set_irq_enabled_with_callback(BTNB, GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
-  gpio_set_irq_enabled_with_callback(SEL_PIN, GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
-
-  adc_gpio_init(Y_PIN);
-  adc_gpio_init(X_PIN);
-  adc_gpio_init(MIC_PIN);
-  adc_init(); // Inicializa o módulo ADC
-  adc_set_clkdiv(96.0f); // Configura o divisor de clock do ADC
-
-  pwm_init_buzzer(BUZZA);
-  pwm_init_buzzer(BUZZB);
-  // gpio_init(SEL_PIN);
-
-  gpio_set_dir(LED_R, GPIO_OUT); // Configura o pino do LED_R como saída
-  gpio_set_dir(LED_G, GPIO_OUT); // Configura o pino do LED_R como saída
-  gpio_set_dir(LED_B, GPIO_OUT); // Configura o pino do LED_R como saída
-  gpio_set_dir(BTNA, GPIO_IN);   // Configura o pino do botão A como entrada
-  gpio_set_dir(BTNB, GPIO_IN);   // Configura o pino do botão B como entrada
-  gpio_set_dir(SEL_PIN, GPIO_IN);
-
-  gpio_put(LED_R, 0); // Garante que o LED_R comece desligado
-  gpio_put(LED_G, 0); // Garante que o LED_G comece desligado
-  gpio_put(LED_B, 0); // Garante que o LED_B comece desligado
-  gpio_pull_up(BTNA); // Habilita o resistor de pull-up no botão A
-  gpio_pull_up(BTNB); // Habilita o resistor de pull-up no botão B
-  gpio_put(BUZZA, 0);
-  gpio_put(BUZZB, 0);
-  gpio_pull_up(SEL_PIN);
+  hal_gpio_output(LED_R); // LEDs começam desligados
+  hal_gpio_output(LED_G);
+  hal_gpio_output(LED_B);
+  hal_gpio_input_pullup(BTNA); // Botões com pull-up, ativos em 0
+  hal_gpio_input_pullup(BTNB);
+  hal_gpio_input_pullup(SEL_PIN);
+  const uint8_t button_pins[] = {BTNA, BTNB, SEL_PIN};
+  input_init(&buttons, button_pins, count_of(button_pins));
+  hal_gpio_irq_edges(BTNA, &gpio_callback);
+  hal_gpio_irq_edges(BTNB, &gpio_callback);
+  hal_gpio_irq_edges(SEL_PIN, &gpio_callback);
+
+  hal_adc_gpio_init(Y_PIN);
+  hal_adc_gpio_init(X_PIN);
+  hal_adc_gpio_init(MIC_PIN);
+  hal_adc_init(); // Inicializa o módulo ADC
+
+  hal_buzzer_init(BUZZA);
+  hal_buzzer_init(BUZZB);
 }
 
 // Função para inicializar o I2C
 void init_i2c()
 {
-  // I2C is "open drain", pull ups to keep signal high when no data is being sent
-  i2c_init(i2c1, SSD1306_I2C_CLK * 1000);
-  gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
-  gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
-  gpio_pull_up(I2C_SDA_PIN);
-  gpio_pull_up(I2C_SCL_PIN);
+  hal_i2c_init(I2C_SDA_PIN, I2C_SCL_PIN, SSD1306_I2C_CLK * 1000);
 
   // run through the complete initialization process
   SSD1306_init();
-
-  // Mensagem de confirmação da inicialização do I2C
-  printf("I2C Iniciado!\n");
 }
 
 
-uint8_t joystick() // Função para controlar o menu com o joystick
-{ 
-  int horz = (200 * read_adc(ADC_HORZ) / 4094);
-  printf("aquij1\n");
-  int vert = (200 * read_adc(ADC_VERT) / 4094);
-  printf("aquij2\n");
-  horz -= 100;
-  vert -= 100;
-  uint8_t page = 3;
-
-  if (abs(horz) < 10 && abs(vert) < 10)
-    page = 3;
-  else if (vert < -10 && vert < horz)
-  {
-    page = 1;
-  }
-  else if (vert > 10 && vert > abs(horz))
-    page = 2;
-  else if (horz < -10 && horz < vert)
-    page = 4;
-  else if (horz > 10 && horz > vert)
-    page = 5;
-  bool savePressed = gpio_get(BTNB); //////////////////////////
-  if (btn_b_pressed == true)
-  {
-    saved_page = page;
-    btn_b_pressed = false;
-  }
-
-  printf("x:%4d, y:%4d, page:%u\n", horz, vert, page);
-
-  return page;
-}
-
 // Função para limpar o display
 void clear_display(uint8_t *buf, struct render_area *frame_area)
 {
@@ -400,7 +489,7 @@ void display_rasp(uint8_t *buf, struct render_area *frame_area)
   }
 
   SSD1306_scroll(true); // Ativa a rolagem
-  sleep_ms(2000);
+  hal_sleep_ms(2000);
   SSD1306_scroll(false); // Desativa a rolagem
 
   // Configura a área para renderizar o logo, também com offset vertical
@@ -413,21 +502,7 @@ void display_rasp(uint8_t *buf, struct render_area *frame_area)
   calc_render_area_buflen(&area_logo);
   render(logo_embarcatech, &area_logo); // Renderiza o logo
 
-  sleep_ms(2000);
-}
-
-// Função para testar a frequência do buzzer
-void frequency_sweep_test(uint pin)
-{
-  printf("Iniciando teste de frequencia:\n");
-
-  for (uint freq = 2500; freq <= 7500; freq += 50)
-  {
-    printf("Testando %4u Hz...\n", freq);
-    play_tone(pin, freq, 200);
-  }
-
-  printf("Teste concluido!\n");
+  hal_sleep_ms(2000);
 }
 
 // Função para inicializar o display
@@ -442,15 +517,15 @@ void init_display()
   for (int i = 0; i < 3; i++)
   {
     SSD1306_send_cmd(SSD1306_SET_ALL_ON); // Liga todos os pixels
-    sleep_ms(10);
+    hal_sleep_ms(10);
     SSD1306_send_cmd(SSD1306_SET_ENTIRE_ON); // Volta ao modo normal
-    sleep_ms(10);
+    hal_sleep_ms(10);
   }
 
   display_rasp(buf, &frame_area); // Exibe as framboesas
 
-  play_music(BUZZA, intro_melody, sizeof(intro_melody) / sizeof(intro_melody[0]));
-  gpio_put(LED_G, 0);
+  melody_start(BUZZA, intro_melody, sizeof(intro_melody) / sizeof(intro_melody[0]), false);
+  hal_gpio_put(LED_G, 0);
 
   const char *text[] = {
       "   S I M I S   ",
@@ -464,47 +539,27 @@ void init_display()
 
   int num_lines = sizeof(text) / sizeof(text[0]);           // Calcula o número de linhas
   show_text(text, num_lines, buf, &frame_area, true, 3000); // Exibe o texto
-  sleep_ms(2000);
+  hal_sleep_ms(2000);
   clear_display(buf, &frame_area); // Limpa o display
 }
 
+// Tempo permitido no nível db pelo critério atual, em horas (tabela de dose.h)
 float calculate_safe_exposure(float db)
 {
-  if (db <= 70.0f)
-  {
-    return INFINITY; // Tempo ilimitado
-  }
-  else if (db <= 85.0f)
-  {
-    return 8.0f; // 8 horas (valor base)
-  }
-  else
-  {
-    float steps = (db - 85.0f) / 3.0f;
-    return 8.0f * powf(0.5f, steps);
-  }
+  return dose_allowed_seconds(dose_criterion, db) / 3600.0f; // INFINITY abaixo do limiar
 }
 
 ExposureLimit get_exposure_details(float db)
 {
   ExposureLimit result;
 
+  result.max_hours = calculate_safe_exposure(db);
   if (db <= 70.0f)
-  {
-    result.max_hours = INFINITY;
     result.warning = "Ambiente seguro";
-  }
   else if (db <= 85.0f)
-  {
-    result.max_hours = 8.0f;
     result.warning = " Uso  moderado ";
-  }
   else
-  {
-    float steps = (db - 85.0f) / 3.0f;
-    result.max_hours = 8.0f * powf(0.5f, steps);
     result.warning = "Perigo auditivo";
-  }
 
   return result;
 }
@@ -519,339 +574,1294 @@ TimeComponents getTimeComponents(double elapsed)
   return tc;
 }
 
-void calculate_safe_values()
+// Desenha o Leq de cada banda como gráfico de barras (30 a 110 dB)
+void draw_bands_page(uint8_t *buf, bool octave)
 {
-  // Calcula o tempo seguro (em segundos) para cada faixa
-  safe_values[0] = calculate_safe_exposure(85.0f) * 3600.0f;
-  safe_values[1] = calculate_safe_exposure(88.0f) * 3600.0f;
-  safe_values[2] = calculate_safe_exposure(91.0f) * 3600.0f;
-  safe_values[3] = calculate_safe_exposure(94.0f) * 3600.0f;
-  safe_values[4] = calculate_safe_exposure(97.0f) * 3600.0f;
-  return;
+  static const char *octave_labels[BANDS_OCTAVE_COUNT] = {"63", "125", "250", "500", "1K", "2K", "4K", "8K"};
+  static const char *third_labels[BANDS_THIRD_COUNT] = {
+      "63", "80", "100", "125", "160", "200", "250", "315", "400", "500", "630",
+      "800", "1K", "1K25", "1K6", "2K", "2K5", "3K15", "4K", "5K", "6K3", "8K"};
+
+  const int count = octave ? BANDS_OCTAVE_COUNT : BANDS_THIRD_COUNT;
+  const int bar_w = octave ? 12 : 4;
+  const int pitch = octave ? 16 : 5;
+  const int x0 = octave ? 2 : 9;
+  const int graph_y0 = 16;
+  const int graph_h = SSD1306_HEIGHT - graph_y0;
+  const float db_min = 30.0f, db_max = 110.0f;
+
+  memset(buf, 0, SSD1306_BUF_LEN);
+
+  int loudest = 0;
+  float loudest_db = 0.0f;
+  for (int b = 0; b < count; b++)
+  {
+    float db = mean_square_db(octave ? meas.octave_ms[b] : meas.third_ms[b]);
+    if (db > loudest_db)
+    {
+      loudest_db = db;
+      loudest = b;
+    }
+
+    int h = (int)((db - db_min) / (db_max - db_min) * graph_h);
+    DrawBarMeter(buf, x0 + b * pitch, graph_y0, bar_w, graph_h, h);
+  }
+
+  char title[20], peak_str[20];
+  snprintf(title, sizeof(title), octave ? "OITAVAS  LEQ" : "TERCO DE OITAVA");
+  snprintf(peak_str, sizeof(peak_str), "MAX %s %.1f", octave ? octave_labels[loudest] : third_labels[loudest], loudest_db);
+  WriteString(buf, 0, 0, title);
+  WriteString(buf, 0, 8, peak_str);
+}
+
+// Gráfico do histórico (envelope.h): uma coluna por pixel, a mais recente à direita.
+// Cada coluna acende do mínimo ao máximo e o Leq fica apagado dentro da faixa.
+void draw_level_graph(uint8_t *buf, uint8_t zoom)
+{
+  static const char *spans[ENV_TIERS] = {"2 min", "2 h", "10 h"};
+  static EnvTier view; // Grande demais para a pilha do núcleo 0
+  const int graph_y0 = 16;
+  const int graph_h = SSD1306_HEIGHT - graph_y0;
+  const int32_t cdb_min = 3000, cdb_max = 11000;
+
+  seqlock_read(&env_lock, &view, &env_shared[zoom], sizeof(view));
+  memset(buf, 0, SSD1306_BUF_LEN);
+
+  uint32_t filled = env_filled(&view);
+  int32_t window_max = INT32_MIN;
+  for (uint32_t age = 0; age < filled; age++)
+  {
+    const EnvColumn *c = env_column(&view, age);
+    if (c->max_cdb > window_max)
+      window_max = c->max_cdb;
+
+    int x = SSD1306_WIDTH - 1 - age;
+    int y_top = graph_y0 + graph_h - 1 - (c->max_cdb - cdb_min) * graph_h / (cdb_max - cdb_min);
+    int y_bottom = graph_y0 + graph_h - 1 - (c->min_cdb - cdb_min) * graph_h / (cdb_max - cdb_min);
+    int y_leq = graph_y0 + graph_h - 1 - (c->leq_cdb - cdb_min) * graph_h / (cdb_max - cdb_min);
+    y_top = y_top < graph_y0 ? graph_y0 : y_top;
+    y_bottom = y_bottom >= SSD1306_HEIGHT ? SSD1306_HEIGHT - 1 : y_bottom;
+    if (y_top > y_bottom)
+      continue;
+    DrawVLine(buf, x, y_top, y_bottom, true);
+    if (y_bottom - y_top >= 2 && y_leq > y_top && y_leq < y_bottom)
+      DrawVLine(buf, x, y_leq, y_leq, false);
+  }
+
+  char line1[32], line2[32];
+  if (filled)
+    snprintf(line1, sizeof(line1), "Leq %.1f  Max %.1f dB", env_column(&view, 0)->leq_cdb * 0.01f, window_max * 0.01f);
+  else
+    snprintf(line1, sizeof(line1), "Leq --  Max -- dB");
+  if (env_column_s[zoom] < 60)
+    snprintf(line2, sizeof(line2), "Ultimos %s  %u s/col", spans[zoom], env_column_s[zoom]);
+  else
+    snprintf(line2, sizeof(line2), "Ultimos %s  %u min/col", spans[zoom], env_column_s[zoom] / 60);
+  WriteStringProp(buf, 0, 0, line1);
+  WriteStringProp(buf, 0, 8, line2);
+}
+
+// Executa um comando recebido do núcleo 0
+void acquisition_command(uint8_t cmd, uint8_t arg)
+{
+  switch (cmd)
+  {
+  case CMD_RESET_EXPOSURE:
+    dose_reset(&acq.dose);
+    acq.exposure_epoch++;
+    break;
+  case CMD_SET_WEIGHTING:
+    if (arg < WEIGHT_COUNT)
+      set_weighting((Weighting)arg);
+    break;
+  case CMD_ADD_EXPOSURE_97:
+    dose_update(&acq.dose, 97.0f, arg * 60u * MIC_SAMPLE_RATE_HZ);
+    break;
+  case CMD_RESET_STATS:
+    stats_reset(&acq_stats);
+    acq.stats_duration_samples = 0;
+    acq.lfmax_stats_cdb = 0;
+    acq.lcpeak_stats_cdb = 0;
+    break;
+  case CMD_SET_BANDS:
+    // Ao religar, a janela parada tem amostras de antes da pausa
+    if (arg && !bands_enabled)
+      bands_discard_window();
+    bands_enabled = arg != 0;
+    break;
+  case CMD_RESUME_EXPOSURE:
+    // Somada, não substituída: a dose medida enquanto o usuário escolhia continua
+    for (int c = 0; c < DOSE_CRITERIA_COUNT; c++)
+      acq.dose.dose[c] += resume_dose[c];
+    acq.dose.duration_samples += resume_duration_samples;
+    break;
+  }
 }
 
-void loop_display()
+// Um passo do núcleo 1: consome comandos e amostras e, a cada bloco de medição,
+// atualiza o nível e a exposição e publica o retrato para o núcleo 0
+void acquisition_step()
 {
-  static uint64_t last_update = 0;
-  // Atualiza a 10 FPS (33ms por frame)
-  if (time_us_64() - last_update < 99000)
+  uint32_t cmd;
+  while (spsc_pop(&core1_cmds, &cmd))
+    acquisition_command(cmd >> 8, cmd & 0xff);
+
+  static uint32_t capture_max_us = 0, bands_max_us = 0;
+  uint32_t t0 = hal_time_us_32();
+  mic_capture_service(mic_block_ready);
+  uint32_t t1 = hal_time_us_32();
+  if (bands_enabled)
+    bands_service(); // No máximo uma janela da FFT por passo
+  uint32_t t2 = hal_time_us_32();
+  if (t1 - t0 > capture_max_us)
+    capture_max_us = t1 - t0;
+  if (t2 - t1 > bands_max_us)
+    bands_max_us = t2 - t1;
+
+  if (mic_sample_count < ACQ_BLOCK_SAMPLES)
     return;
-  last_update = time_us_64();
-  printf("aqui1\n");
-  uint8_t page = joystick();
-  printf("aqui2\n");
-  if (page == 3)
-  {
-    page = saved_page;
-  }
-  printf("aqui3\n");
-  float avg = mic_power();
-  float intensity = get_intensity(avg);
-  if (intensity > max_peak)
-    max_peak = intensity;
-  find_led(intensity);
-  ExposureLimit limit = get_exposure_details(intensity);
 
-  mic_readings[reading_index] = intensity;
-  reading_index = (reading_index + 1) % NUM_READINGS;
+  uint64_t energy = mic_energy;
+  // O tempo vem das próprias amostras, então atrasos do núcleo não afetam a exposição
+  uint32_t samples = mic_sample_count;
+  int32_t level_cdb = mic_level_cdb();
+  float intensity = level_cdb * 0.01f;
+  stats_add(&acq_stats, level_cdb, energy, samples);
+  acq.stats_duration_samples += samples;
+
+  uint32_t closed = env_add(&env_acq, level_cdb, energy, samples);
+  for (int t = 0; t < ENV_TIERS; t++)
+    if (closed & (1u << t))
+      seqlock_write(&env_lock, &env_shared[t], &env_acq.tier[t], sizeof(EnvTier));
+
+  // Fecha um minuto a cada 60 s de amostras
+  minute_energy += energy;
+  minute_samples += samples;
+  if (minute_samples == samples || level_cdb > minute_max_cdb)
+    minute_max_cdb = level_cdb;
+  if (minute_samples >= 60ull * MIC_SAMPLE_RATE_HZ)
+  {
+    acq.minute_leq_cdb = level_cdb_from_energy(minute_energy, minute_samples, MIC_LEVEL_OFFSET_CDB);
+    acq.minute_lmax_cdb = minute_max_cdb;
+    acq.minute_count++;
+    minute_energy = 0;
+    minute_samples = 0;
+  }
 
-  // Considerando que cada iteração tem ~10 ms de intervalo
-  // Calcula o tempo decorrido em segundos desde a última iteração
-  uint64_t current_time = time_us_64();
-  float dt = (current_time - last_time) / 1000000.0f; // dt em segundos
-  last_time = current_time;
+  acq.intensity = intensity;
+  acq.level_cdb = level_cdb;
+  acq.mic_readings[acq.reading_index] = intensity;
+  recent_energy[acq.reading_index] = energy;
+  recent_samples[acq.reading_index] = samples;
+  acq.reading_index = (acq.reading_index + 1) % NUM_READINGS;
+
+  // Detectores rodaram amostra a amostra; aqui só o fechamento do bloco
+  acq.lf_cdb = tw_level_cdb(mic_tw.fast, MIC_LEVEL_OFFSET_CDB);
+  acq.ls_cdb = tw_level_cdb(mic_tw.slow, MIC_LEVEL_OFFSET_CDB);
+  acq.li_cdb = tw_level_cdb(mic_tw.impulse_hold, MIC_LEVEL_OFFSET_CDB);
+  acq.lfmax_cdb = tw_level_cdb(mic_tw.fast_max, MIC_LEVEL_OFFSET_CDB);
+  acq.lcpeak_cdb = tw_peak_cdb(mic_tw.peak, MIC_LEVEL_OFFSET_CDB);
+  tw_block_reset(&mic_tw);
+  if (acq.lfmax_cdb > acq.lfmax_stats_cdb)
+    acq.lfmax_stats_cdb = acq.lfmax_cdb;
+  if (acq.lcpeak_cdb > acq.lcpeak_stats_cdb)
+    acq.lcpeak_stats_cdb = acq.lcpeak_cdb;
+  if (acq.lcpeak_cdb >= PEAK_ALARM_CDB)
+    acq.peak_alarm_blocks++; // Contador: o núcleo 0 não perde o pico se pular o retrato
+  if (mic_clipped)
+    acq.over_range_blocks++;
+  mic_clipped = false;
+
+  uint64_t recent_e = 0, recent_n = 0;
+  acq.recent_peak = 0.0f;
+  for (int i = 0; i < NUM_READINGS; i++)
+  {
+    recent_e += recent_energy[i];
+    recent_n += recent_samples[i];
+    if (acq.mic_readings[i] > acq.recent_peak)
+      acq.recent_peak = acq.mic_readings[i];
+  }
+  acq.recent_leq = level_cdb_from_energy(recent_e, recent_n, MIC_LEVEL_OFFSET_CDB) * 0.01f;
+  stats_summary(&acq_stats, MIC_LEVEL_OFFSET_CDB, &acq.stats);
 
-  if (intensity >= 85.0f)
-    elapsed85 += dt;
-  if (intensity >= 88.0f)
-    elapsed88 += dt;
-  if (intensity >= 91.0f)
-    elapsed91 += dt;
-  if (intensity >= 94.0f)
-    elapsed94 += dt;
-  if (intensity >= 97.0f)
-    elapsed97 += dt;
+  // Amostras perdidas (núcleo parado além do anel) não têm nível medido; o intervalo
+  // entra na dose com o nível deste bloco, para a exposição não ficar menor que a real
+  uint64_t lost = mic_capture_get_stats().lost;
+  dose_update(&acq.dose, intensity, samples + (uint32_t)(lost - acq.capture.lost));
 
-  if (!alarmActive)
+  acq.weighting = mic_weighting_type;
+  if (bands_enabled)
   {
+    for (int b = 0; b < BANDS_THIRD_COUNT; b++)
+      acq.third_ms[b] = bands_mean_square(false, b);
+    for (int b = 0; b < BANDS_OCTAVE_COUNT; b++)
+      acq.octave_ms[b] = bands_mean_square(true, b);
+  }
+  acq.capture = mic_capture_get_stats();
+  acq.mic_baseline_q4 = dc_block_baseline_q4(&mic_dc);
+  uint32_t block_us = (uint32_t)(samples * 1000000ull / MIC_SAMPLE_RATE_HZ);
+  uint32_t load = (uint32_t)(core1_busy_us * 1000ull / block_us);
+  acq.core1_load_permille = load > 1000 ? 1000 : load;
+  core1_busy_us = 0;
+
+  acq.blocks++;
+  acq.capture_us = capture_max_us > 0xFFFF ? 0xFFFF : capture_max_us;
+  acq.bands_us = bands_max_us > 0xFFFF ? 0xFFFF : bands_max_us;
+  uint32_t level_us = hal_time_us_32() - t2;
+  acq.level_us = level_us > 0xFFFF ? 0xFFFF : level_us;
+  capture_max_us = 0;
+  bands_max_us = 0;
+
+  seqlock_write(&meas_lock, &meas_shared, &acq, sizeof(acq));
+}
 
-    // Prioriza o alarme de volume máximo
-    if (intensity >= MAX_VOLUME_THRESHOLD)
-    {
-      alarmCountMaxVolume++;
-      triggerAlarm("VolMax excedido");
-      alarmActive = true;
-    }
-    // Verifica os tempos acumulados para cada faixa (pode-se escolher a condição mais severa)
-    else if (elapsed97 >= safe_values[4])
-    {
-      alarmCountSafe++;
-      triggerAlarm("Temp Expos 97dB");
-      alarmActive = true;
-    }
-    else if (elapsed94 >= safe_values[3])
-    {
-      alarmCountSafe++;
-      triggerAlarm("Temp Expos 94dB");
-      alarmActive = true;
-    }
-    else if (elapsed91 >= safe_values[2])
-    {
-      alarmCountSafe++;
-      triggerAlarm("Temp Expos 91dB");
-      alarmActive = true;
-    }
-    else if (elapsed88 >= safe_values[1])
-    {
-      alarmCountSafe++;
-      triggerAlarm("Temp Expos 88dB");
-      alarmActive = true;
-    }
-    else if (elapsed85 >= safe_values[0])
-    {
-      alarmCountSafe++;
-      triggerAlarm("Temp Expos 85dB");
-      alarmActive = true;
-    }
+// Inicialização do núcleo 1. A captura é iniciada aqui para que a interrupção
+// do DMA fique neste núcleo.
+void acquisition_init()
+{
+  hal_core1_lockout_victim_init(); // Permite ao núcleo 0 pausar este durante a gravação da flash
+  bands_init(MIC_SAMPLE_RATE_HZ); // Tabelas da FFT e das bandas, uma vez
+  set_weighting(mic_weighting_type);
+  dc_block_init(&mic_dc);
+  tw_init(&mic_tw);
+  env_init(&env_acq, MIC_LEVEL_OFFSET_CDB, MIC_SAMPLE_RATE_HZ);
+  mic_capture_init(ADC_MIC, (1u << ADC_HORZ) | (1u << ADC_VERT)); // A partir daqui o ADC roda livre, com o joystick intercalado
+}
+
+// Quanto o núcleo 1 pode dormir: até o próximo bloco da captura ficar completo, com
+// uma folga para o DMA escrever a última amostra. Cada bloco de 512 amostras é
+// processado assim que fica pronto e a janela das bandas não perde amostras.
+#define ACQ_WAKE_MARGIN_US 50
+
+uint32_t acquisition_sleep_us()
+{
+  return mic_capture_us_to_next_block() + ACQ_WAKE_MARGIN_US;
+}
+
+// Ponto de entrada do núcleo 1. Entre os blocos o núcleo dorme (WFE) em vez de
+// consultar a captura a cada 2 ms.
+void core1_entry()
+{
+  acquisition_init();
+  while (true)
+  {
+    uint32_t t0 = hal_time_us_32();
+    acquisition_step();
+    core1_busy_us += hal_time_us_32() - t0;
+    hal_sleep_us(acquisition_sleep_us()); // O anel guarda 170 ms de amostras
   }
+}
 
-  while (alarmActive)
+// Telemetria binária pela USB (telemetry.h). Um quadro TEL_LEVEL a cada
+// telemetry_level_divider blocos publicados (0 desliga); como o núcleo 0 lê só o
+// retrato mais recente, blocos podem faltar e o índice do bloco mostra a lacuna.
+// TEL_TIMING e TEL_STATUS a cada TELEMETRY_STATUS_BLOCKS blocos. O host troca o
+// divisor enviando um dígito de '0' a '9', liga ('L') ou desliga ('N') o modo de
+// baixo consumo e pede ('H') o histórico em flash, enviado em quadros TEL_HISTORY,
+// TELEMETRY_HISTORY_BATCH por quadro da interface.
+#ifndef TELEMETRY_LEVEL_DIVIDER
+#define TELEMETRY_LEVEL_DIVIDER 1
+#endif
+#define TELEMETRY_STATUS_BLOCKS 10
+#define TELEMETRY_HISTORY_BATCH 32
+
+uint8_t telemetry_level_divider = TELEMETRY_LEVEL_DIVIDER;
+uint8_t telemetry_seq = 0;
+bool history_dump_requested = false; // 'H' recebido; atendido por history_dump_service()
+uint32_t ui_frame_us = 0; // Duração do último quadro da interface
+
+// Tarefas do núcleo 0 (sched.h), na ordem de core0_tasks[]
+enum
+{
+  TASK_INPUT = 0,
+  TASK_UI,
+  TASK_HISTORY,
+  CORE0_TASKS
+};
+Scheduler core0_sched;
+
+void telemetry_send(uint8_t type, const void *payload, size_t len)
+{
+  uint8_t frame[TELEMETRY_MAX_FRAME];
+  size_t n = telemetry_frame(type, telemetry_seq++, payload, len, frame);
+  for (size_t i = 0; i < n; i++)
+    hal_serial_putc(frame[i]);
+}
+
+void telemetry_alarm(AlarmState previous, AlarmState state, const char *reason)
+{
+  TelAlarm msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.block = meas.blocks;
+  msg.state = (uint8_t)state;
+  msg.previous = (uint8_t)previous;
+  if (reason)
+    strncpy(msg.reason, reason, sizeof(msg.reason) - 1);
+  telemetry_send(TEL_ALARM, &msg, sizeof(msg));
+}
+
+// Atende comandos do host e envia os quadros periódicos do retrato atual
+void telemetry_service()
+{
+  int c;
+  while ((c = hal_serial_getc()) >= 0)
   {
-    triggerAlarm(lastAlarmReason);
-    if (btn_a_pressed)
-    {
-      alarmActive = false;
-      btn_a_pressed = false;
-      elapsed85 = 0.0f;
-      elapsed88 = 0.0f;
-      elapsed91 = 0.0f;
-      elapsed94 = 0.0f;
-      elapsed97 = 0.0f;
-    }
-    sleep_ms(10);
+    if (c >= '0' && c <= '9')
+      telemetry_level_divider = (uint8_t)(c - '0');
+    else if (c == 'L' || c == 'N')
+      power.low_power = c == 'L';
+    else if (c == 'H')
+      history_dump_requested = true;
   }
 
-  // clear_display(buf, &frame_area);
-  switch (page)
+  static uint32_t last_level_block = 0, last_status_block = 0;
+  if (telemetry_level_divider && meas.blocks - last_level_block >= telemetry_level_divider)
   {
-  case 1:
+    last_level_block = meas.blocks;
+    TelLevel msg;
+    msg.block = meas.blocks;
+    msg.level_cdb = (int16_t)meas.level_cdb;
+    msg.recent_leq_cdb = (int16_t)(meas.recent_leq * 100.0f);
+    msg.dose_niosh = dose_to_x10000(meas.dose.dose[DOSE_NIOSH]);
+    msg.dose_osha = dose_to_x10000(meas.dose.dose[DOSE_OSHA]);
+    msg.weighting = (uint8_t)meas.weighting;
+    msg.alarm_state = (uint8_t)alarm_state;
+    telemetry_send(TEL_LEVEL, &msg, sizeof(msg));
+  }
+
+  if (meas.blocks - last_status_block >= TELEMETRY_STATUS_BLOCKS)
   {
-    // Variáveis locais ao case 1
-    char volume_str[30], tempo_str[30];
+    last_status_block = meas.blocks;
+    TelTiming timing;
+    timing.block = meas.blocks;
+    timing.capture_us = meas.capture_us;
+    timing.bands_us = meas.bands_us;
+    timing.level_us = meas.level_us;
+    timing.frame_us = ui_frame_us > 0xFFFF ? 0xFFFF : ui_frame_us;
+    timing.render_wait_us = ssd1306_stats.last_wait_us > 0xFFFF ? 0xFFFF : ssd1306_stats.last_wait_us;
+    timing.input_misses = (uint16_t)core0_sched.tasks[TASK_INPUT].misses;
+    timing.frame_misses = (uint16_t)core0_sched.tasks[TASK_UI].misses;
+    timing.history_misses = (uint16_t)core0_sched.tasks[TASK_HISTORY].misses;
+    telemetry_send(TEL_TIMING, &timing, sizeof(timing));
+
+    TelStatus status;
+    status.block = meas.blocks;
+    status.lost = (uint32_t)meas.capture.lost;
+    status.overruns = meas.capture.overruns;
+    status.fifo_overflows = meas.capture.fifo_overflows;
+    status.oled_bytes = ssd1306_stats.last_bytes;
+    status.oled_errors = ssd1306_stats.tx_errors;
+    status.mic_baseline_q4 = (uint16_t)meas.mic_baseline_q4;
+    uint32_t mw_x10 = power_window_mw_x10(&power);
+    status.power_mw_x10 = mw_x10 > 0xFFFF ? 0xFFFF : (uint16_t)mw_x10;
+    status.clock_mhz = (uint8_t)(power.clock_khz / 1000);
+    status.display = (uint8_t)power.display;
+    status.over_range = (uint16_t)overRangeCount;
+    telemetry_send(TEL_STATUS, &status, sizeof(status));
+  }
+}
+
+// Aplica ao display o estado pedido pelo modo de baixo consumo
+void power_apply_display(PowerDisplay target)
+{
+  if (target == power.display)
+    return;
+  if (power.display == POWER_DISPLAY_OFF)
+    SSD1306_set_display_on(true);
+  if (target == POWER_DISPLAY_OFF)
+    SSD1306_set_display_on(false);
+  else
+    SSD1306_set_contrast(target == POWER_DISPLAY_DIM ? POWER_CONTRAST_DIM : POWER_CONTRAST_FULL);
+  power.display = target;
+}
+
+// Troca o relógio do sistema conforme a carga do núcleo 1. Não troca com uma melodia
+// tocando, pois o período do PWM do buzzer foi calculado para o relógio atual.
+void power_apply_clock()
+{
+  uint32_t target = power_clock_target(&power, meas.core1_load_permille);
+  if (target == power.clock_khz || melody_is_playing())
+    return;
+  SSD1306_tx_flush(); // O I2C não pode estar transmitindo quando o clk_peri muda
+  if (hal_set_sys_clock_khz(target))
+    power.clock_khz = target;
+}
 
-    // Formatação numérica
-    snprintf(volume_str, sizeof(volume_str), "     %.2f dB   ", intensity);
-    snprintf(tempo_str, sizeof(tempo_str),   "     %.2f h    ", limit.max_hours);
+// Soma à estimativa de consumo o intervalo desde o quadro anterior, com o estado em
+// que ele ficou (buf ainda tem o último quadro desenhado). A carga do núcleo 0 é o
+// tempo passado em todas as tarefas dele no intervalo.
+void power_update_estimate(uint64_t now)
+{
+  static uint64_t last_busy_us = 0;
+  uint64_t dt = now - power.last_account_us;
+  uint64_t core0 = dt ? (core0_sched.busy_us - last_busy_us) * 1000ull / dt : 0;
+  last_busy_us = core0_sched.busy_us;
+
+  PowerLoad l;
+  l.clock_khz = power.clock_khz;
+  l.core0_load_permille = core0 > 1000 ? 1000 : (uint16_t)core0;
+  l.core1_load_permille = meas.core1_load_permille;
+  l.display_on = power.display != POWER_DISPLAY_OFF;
+  l.lit_permille = l.display_on ? power_lit_permille(buf, SSD1306_BUF_LEN) : 0;
+  l.contrast = power.display == POWER_DISPLAY_DIM ? POWER_CONTRAST_DIM : POWER_CONTRAST_FULL;
+  l.leds_on = hal_gpio_get(LED_R) + hal_gpio_get(LED_G) + hal_gpio_get(LED_B);
+  l.buzzer_on = melody_is_playing();
+  power_account(&power, power_estimate_ua(&l), now);
+}
 
-    // Array de texto com escopo local
-    const char *text[] = {
-        "MONITOR  SONORO",
-        "               ",
-        " Status  Atual ",
-        limit.warning,
-        "  Intensidade  ",
-        volume_str,
-        " Tempo  seguro ",
-        isinf(limit.max_hours) ? "   ILIMITADO   " : tempo_str};
+// Avança a máquina de estados do alarme e executa a ação de entrada do novo estado
+void alarm_dispatch(AlarmEvent event, const char *reason, bool max_volume)
+{
+  AlarmState next = alarm_next(alarm_state, event);
+  if (next == alarm_state)
+    return;
+  telemetry_alarm(alarm_state, next, reason);
+  alarm_state = next;
+  pages_touch(&ui_view, PAGE_DEP_ALARMS);
 
-    const int num_lines = sizeof(text) / sizeof(text[0]);
-    memset(buf, 0, SSD1306_BUF_LEN);
-    show_text(text, num_lines, buf, &frame_area, false, 1000);
+  switch (next)
+  {
+  case ALARM_FIRING:
+    // O alarme conta como entrada: o display volta ao brilho normal para a tela dele
+    power_input(&power, hal_time_us_64());
+    power_apply_display(POWER_DISPLAY_ON);
+    if (max_volume)
+      alarmCountMaxVolume++;
+    else
+      alarmCountSafe++;
+    alarm_is_dose = !max_volume;
+    triggerAlarm(reason);
+    pages_invalidate(&ui_view); // A tela de alarme ficou no buffer
+    break;
+  case ALARM_ACKNOWLEDGED:
+    melody_stop();
+    hal_gpio_put(LED_R, 0);
+    // Só o reconhecimento do alarme de dose zera a dose (começa uma nova contagem de
+    // 100%); silenciar um alarme de volume ou de pico não apaga a exposição da jornada
+    if (alarm_is_dose && core1_send(CMD_RESET_EXPOSURE, 0))
+      exposure_epoch_requested++;
+    break;
+  default:
     break;
   }
+}
 
-  case 2:
+// Histórico em flash (flash_log.h) na área livre depois da imagem do programa,
+// gravado pelo núcleo 0 (hal_flash_*).
+FlashLog flash_log;
+uint16_t flash_log_boot = 0;   // Número desta inicialização
+uint32_t logged_minutes = 0;   // Último meas.minute_count registrado
+HalResetReason history_reset_reason = HAL_RESET_POWER;
+FlashLogShift history_shift = FLASH_LOG_SHIFT_NEW; // Origem da dose desta inicialização
+FlashLogRecord history_last;   // Último registro da inicialização anterior
+uint64_t history_prompt_until_us = 0; // Fim da pergunta de retomada
+int history_prompt_shown_s = -1;      // Segundos restantes na pergunta desenhada
+
+// Setores do histórico apagados com antecedência na inicialização (127 min cada)
+#ifndef HISTORY_PREERASE_SECTORS
+#define HISTORY_PREERASE_SECTORS 8
+#endif
+
+// Tempo para o usuário escolher entre retomar a jornada e começar uma nova
+#ifndef HISTORY_RESUME_WAIT_S
+#define HISTORY_RESUME_WAIT_S 15
+#endif
+
+// Retoma a dose, o tempo de exposição e os contadores de alarme do último registro
+// da inicialização anterior (os minutos ainda não gravados se perdem)
+void history_resume(const FlashLogRecord *r)
+{
+  resume_dose[DOSE_NIOSH] = r->dose_niosh / 10000.0;
+  resume_dose[DOSE_OSHA] = r->dose_osha / 10000.0;
+  resume_duration_samples = (uint64_t)r->shift_minutes * 60u * MIC_SAMPLE_RATE_HZ;
+  if (!core1_send(CMD_RESUME_EXPOSURE, 0))
   {
-    memset(buf, 0, SSD1306_BUF_LEN);
-    // Parâmetros do gráfico
-    const int graph_x0 = 0;
-    const int graph_y0 = 20; // margem superior para textos
-    const int graph_width = SSD1306_WIDTH;
-    const int graph_height = 40; // área reservada para o gráfico
-    const int num_points = NUM_READINGS;
-    const int step_x = graph_width / (num_points - 1);
+    history_shift = FLASH_LOG_SHIFT_NEW;
+    return;
+  }
+  alarmCountSafe += r->alarms_safe;
+  alarmCountMaxVolume += r->alarms_volume;
+  history_shift = FLASH_LOG_SHIFT_RESUMED;
+}
 
-    // Supondo uma escala fixa de dB (por exemplo, de 60 dB a 100 dB)
-    const float dB_min = 0.0f;
-    const float dB_max = 100.0f;
+// Resposta à pergunta de retomada (botão ou fim do prazo)
+void history_choose(bool resume)
+{
+  if (resume)
+    history_resume(&history_last);
+  else
+    history_shift = FLASH_LOG_SHIFT_NEW;
+  pages_invalidate(&ui_view); // A pergunta ficou no buffer
+}
 
-    // Calcula o pico das últimas leituras
-    float peak = 0.0f;
-    float mean = 0.0f;
-    for (int i = 0; i < NUM_READINGS; i++)
+// Abre o histórico, continua a contagem de inicializações e decide de onde parte a
+// dose. Sem relógio de tempo real não há como saber há quanto tempo o último
+// registro foi gravado, então a causa do reset decide:
+// - watchdog: a jornada foi interrompida pelo próprio firmware e é retomada;
+// - energia (inclui o brown-out, que o RP2040 não distingue) ou pino RUN: pode ser
+//   uma queda no meio da jornada ou o começo de outra, então a primeira tela pergunta
+//   (A retoma, B começa uma nova) e, sem resposta em HISTORY_RESUME_WAIT_S, retoma.
+// A escolha vai em cada registro (shift). Também apaga os próximos setores do anel
+// (HISTORY_PREERASE_SECTORS, cerca de 17 h), para que nenhum apagamento pare a
+// captura durante a jornada.
+// Chamada antes de o núcleo 1 começar.
+void history_init()
+{
+  FlashLogIo io;
+  hal_flash_region(&io.base, &io.sectors);
+  io.erase = hal_flash_erase;
+  io.program = hal_flash_program;
+  flash_log_init(&flash_log, &io);
+  history_reset_reason = hal_reset_reason();
+
+  FlashLogRecord *last = &history_last;
+  if (flash_log_last(&flash_log, last))
+  {
+    flash_log_boot = last->boot + 1;
+    bool exposed = last->dose_niosh || last->dose_osha || last->alarms_safe || last->alarms_volume;
+    if (exposed && history_reset_reason == HAL_RESET_WATCHDOG)
+      history_resume(last);
+    else if (exposed)
     {
-      if (mic_readings[i] > peak)
-        peak = mic_readings[i];
-      mean += mic_readings[i];
+      history_shift = FLASH_LOG_SHIFT_PENDING;
+      history_prompt_until_us = hal_time_us_64() + HISTORY_RESUME_WAIT_S * 1000000ull;
     }
-    mean /= NUM_READINGS;
+  }
+  flash_log_prepare(&flash_log, HISTORY_PREERASE_SECTORS);
+}
 
-    // Desenha o gráfico conectando os pontos
-    // Como o buffer é circular, vamos traçar na ordem cronológica:
-    for (int i = 0; i < num_points - 1; i++)
+// Pergunta de retomada, redesenhada quando os segundos restantes mudam
+void history_prompt_frame()
+{
+  uint64_t now = hal_time_us_64();
+  int left = now < history_prompt_until_us ? (int)((history_prompt_until_us - now + 999999) / 1000000) : 0;
+  if (left == history_prompt_shown_s)
+    return;
+  history_prompt_shown_s = left;
+
+  char line2[20], line3[20], line4[20], line7[20];
+  snprintf(line2, sizeof(line2), "NIOSH %7.2f %%", history_last.dose_niosh / 100.0f);
+  snprintf(line3, sizeof(line3), "OSHA  %7.2f %%", history_last.dose_osha / 100.0f);
+  snprintf(line4, sizeof(line4), "Tempo %3uh%02umin", history_last.shift_minutes / 60u, history_last.shift_minutes % 60u);
+  snprintf(line7, sizeof(line7), "Retoma em %2d s", left);
+  const char *text[] = {
+      "RETOMAR JORNADA",
+      "               ",
+      line2,
+      line3,
+      line4,
+      "A: retomar     ",
+      "B: nova jornada",
+      line7};
+
+  memset(buf, 0, SSD1306_BUF_LEN);
+  show_text(text, sizeof(text) / sizeof(text[0]), buf, &frame_area, false, 0);
+}
+
+// Registra o minuto recém-fechado pelo núcleo 1
+void history_log_minute()
+{
+  FlashLogRecord rec;
+  memset(&rec, 0, sizeof(rec));
+  rec.minute = meas.minute_count;
+  rec.boot = flash_log_boot;
+  rec.leq_cdb = (int16_t)meas.minute_leq_cdb;
+  rec.lmax_cdb = (int16_t)meas.minute_lmax_cdb;
+  rec.dose_niosh = dose_to_x10000(meas.dose.dose[DOSE_NIOSH]);
+  rec.dose_osha = dose_to_x10000(meas.dose.dose[DOSE_OSHA]);
+  rec.alarms_safe = (uint16_t)alarmCountSafe;
+  rec.alarms_volume = (uint16_t)alarmCountMaxVolume;
+  rec.alarm_state = (uint8_t)alarm_state;
+  rec.weighting = (uint8_t)meas.weighting;
+  uint64_t shift_minutes = meas.dose.duration_samples / (60u * MIC_SAMPLE_RATE_HZ);
+  rec.shift_minutes = shift_minutes > 0xFFFF ? 0xFFFF : (uint16_t)shift_minutes;
+  rec.reset_reason = (uint8_t)history_reset_reason;
+  rec.shift = (uint8_t)history_shift;
+  flash_log_append(&flash_log, &rec);
+}
+
+// Envia ao host o histórico pedido com 'H', do registro mais antigo ao mais novo. A
+// página pendente na RAM é gravada antes, e os registros gravados durante a leitura
+// (sequência a partir de end_seq) ficam para o próximo pedido.
+void history_dump_service()
+{
+  static FlashLogCursor cursor;
+  static uint32_t end_seq = 0;
+  static bool active = false;
+  if (history_dump_requested)
+  {
+    history_dump_requested = false;
+    flash_log_flush(&flash_log);
+    flash_log_cursor_init(&flash_log, &cursor);
+    end_seq = flash_log.record_seq;
+    active = true;
+  }
+
+  FlashLogRecord r;
+  for (int n = 0; active && n < TELEMETRY_HISTORY_BATCH; n++)
+  {
+    if (!flash_log_next(&flash_log, &cursor, &r))
     {
-      // índice real: partindo do reading_index (ponto mais antigo) até o último
-      int idx1 = (reading_index + i) % NUM_READINGS;
-      int idx2 = (reading_index + i + 1) % NUM_READINGS;
-
-      // Converte cada leitura (em dB) para coordenada Y na área do gráfico:
-      // Quanto maior o dB, mais alto (y menor)
-      int x1 = graph_x0 + i * step_x;
-      int x2 = graph_x0 + (i + 1) * step_x;
-      int y1 = graph_y0 + graph_height - (int)(((mic_readings[idx1] - dB_min) / (dB_max - dB_min)) * graph_height);
-      int y2 = graph_y0 + graph_height - (int)(((mic_readings[idx2] - dB_min) / (dB_max - dB_min)) * graph_height);
-
-      // Desenha a linha entre os pontos (assumindo que DrawLine está disponível)
-      DrawLine(buf, x1, y1, x2, y2, true);
+      active = false;
+      break;
     }
+    if (r.seq >= end_seq)
+      continue;
+    TelHistory msg;
+    msg.seq = r.seq;
+    msg.minute = r.minute;
+    msg.boot = r.boot;
+    msg.leq_cdb = r.leq_cdb;
+    msg.lmax_cdb = r.lmax_cdb;
+    msg.dose_niosh = r.dose_niosh;
+    msg.dose_osha = r.dose_osha;
+    msg.alarms_safe = r.alarms_safe;
+    msg.alarms_volume = r.alarms_volume;
+    msg.alarm_state = r.alarm_state;
+    msg.weighting = r.weighting;
+    msg.shift_minutes = r.shift_minutes;
+    msg.reset_reason = r.reset_reason;
+    msg.shift = r.shift;
+    telemetry_send(TEL_HISTORY, &msg, sizeof(msg));
+  }
+}
+
+// Injeção de exposição para testes: segurar o SEL soma 5 min em 97 dB.
+// Só é compilada com SIMIS_TEST_MODE, pois o SEL também seleciona a ponderação.
+void test()
+{
+#ifdef SIMIS_TEST_MODE
+  if (hal_gpio_get(SEL_PIN) == 0)
+  {
+    core1_send(CMD_ADD_EXPOSURE_97, 5);
+  }
+#endif
+  return;
+}
 
-    // Exibe o valor de pico na parte inferior ou superior do display
-    char peak_str[20];
-    snprintf(peak_str, sizeof(peak_str), " Pico: %.1f dB", peak);
-    WriteString(buf, 0, 2, peak_str);
+// Joystick: cada eixo é a média das últimas JOYSTICK_AVERAGE conversões (1 ms) que o
+// round-robin do ADC intercala na captura do microfone, lida do anel a cada
+// INPUT_PERIOD_US e entregue ao decodificador de gestos (gesture.h)
+#define JOYSTICK_AVERAGE 32
 
-    char mean_str[20];
-    snprintf(mean_str, sizeof(mean_str), " Media: %.1f dB", mean);
-    WriteString(buf, 0, 8, mean_str);
+GestureDecoder joystick_gestures;
+bool joystick_wake = false; // A deflexão que acordou o display é ignorada até voltar ao centro
 
-    render(buf, &frame_area);
-    break;
+// Página mostrada: a escolhida pelo joystick ou, sem ela, a tela inicial
+uint8_t ui_visible_page()
+{
+  return nav_page ? nav_page : saved_page;
+}
+
+// Página de cada direção do joystick
+static uint8_t joystick_page_of(GestureDir dir)
+{
+  switch (dir)
+  {
+  case GESTURE_DIR_DOWN:
+    return 1;
+  case GESTURE_DIR_UP:
+    return 2;
+  case GESTURE_DIR_LEFT:
+    return 4;
+  default:
+    return 5;
   }
-  case 3:
-  {
-    // Array de texto fixo
-    const char *text[] = {
-        "MONITOR  SONORO",
-        "               ",
-        "Use o joystick ",
-        "para se mover  ",
-        "entre as telas ",
-        "e o pressione B",
-        "para travar na ",
-        "tela atual     "};
-
-    const int num_lines = sizeof(text) / sizeof(text[0]);
-    memset(buf, 0, SSD1306_BUF_LEN);
-    show_text(text, num_lines, buf, &frame_area, false, 1000);
-    break;
+}
+
+// Um toque ou uma deflexão mantida abre a página da direção (repetir a direção
+// volta à tela inicial); segurar mais fixa a página como tela inicial
+void joystick_navigate(const GestureEvent *ev)
+{
+  uint8_t page = joystick_page_of(ev->dir);
+  if (ev->kind == GESTURE_LONG_HOLD)
+  {
+    saved_page = page;
+    nav_page = 0;
   }
+  else
+    nav_page = nav_page == page ? 0 : page;
+}
 
-  case 4:
-  {
-    TimeComponents t85 = getTimeComponents(elapsed85);
-    TimeComponents t88 = getTimeComponents(elapsed88);
-    TimeComponents t91 = getTimeComponents(elapsed91);
-    TimeComponents t94 = getTimeComponents(elapsed94);
-    TimeComponents t97 = getTimeComponents(elapsed97);
-
-    // Prepara as strings formatadas
-    char line1[30], line2[30], line3[30], line4[30], line5[30];
-    snprintf(line1, sizeof(line1), "85 dB %01d: %02d: %02d", t85.hours, t85.minutes, t85.seconds);
-    snprintf(line2, sizeof(line2), "88 dB %01d: %02d: %02d", t88.hours, t88.minutes, t88.seconds);
-    snprintf(line3, sizeof(line3), "91 dB %01d: %02d: %02d", t91.hours, t91.minutes, t91.seconds);
-    snprintf(line4, sizeof(line4), "94 dB %01d: %02d: %02d", t94.hours, t94.minutes, t94.seconds);
-    snprintf(line5, sizeof(line5), "97 dB %01d: %02d: %02d", t97.hours, t97.minutes, t97.seconds);
-
-    // Array de strings para ser exibido pela função show_text
-    const char *text[] = {
-        " Tempo exposto ",
-        "               ",
-        " vol  h min seg",
-        line1,
-        line2,
-        line3,
-        line4,
-        line5};
-    int num_lines = sizeof(text) / sizeof(text[0]);
-    memset(buf, 0, SSD1306_BUF_LEN);
-    show_text(text, num_lines, buf, &frame_area, false, 2000);
-    break;
+// Um gesto de botão (input.h), fora de alarme
+void button_event(const InputEvent *ev)
+{
+  if (ev->pin == BTNA && ev->kind == INPUT_LONG)
+  {
+    // A mantido liga ou desliga o modo de baixo consumo
+    power.low_power = !power.low_power;
+  }
+  else if (ev->pin == BTNA)
+  {
+    // A alterna a tela inicial entre ajuda, bandas e estatísticas e volta a ela
+    saved_page = (saved_page == 3) ? PAGE_BANDS : (saved_page == PAGE_BANDS) ? PAGE_STATS : 3;
+    nav_page = 0;
+  }
+  else if (ev->pin == BTNB)
+  {
+    // B fixa a página mostrada como tela inicial; o toque duplo volta à ajuda
+    saved_page = ev->kind == INPUT_DOUBLE ? 3 : ui_visible_page();
+    nav_page = 0;
+  }
+  else if (ev->pin == SEL_PIN && ev->kind != INPUT_LONG)
+  {
+    // O botão do joystick executa a ação da tela atual (mantido, é a injeção de teste)
+    pages_select(&ui_view, ui_visible_page());
   }
+}
 
-  case 5:
-  {
-    // Página de resumo dos alarmes disparados
-    char line1[30], line2[30], line3[30];
-    snprintf(line1, sizeof(line1), "Tempo Expo: %02d", alarmCountSafe);
-    snprintf(line2, sizeof(line2), "Vol Maximo: %02d", alarmCountMaxVolume);
-    snprintf(line3, sizeof(line3), "%s", lastAlarmReason);
-    const char *text[] = {
-        " INFO  ALARMES ",
-        "               ",
-        " QTD. Ativados ",
-        line1,
-        line2,
-        "               ",
-        "Ultimo  Motivo:",
-        line3};
-    int num_lines = sizeof(text) / sizeof(text[0]);
-    memset(buf, 0, SSD1306_BUF_LEN);
-    show_text(text, num_lines, buf, &frame_area, false, 3000);
-    break;
+// Tarefa de entrada (INPUT_PERIOD_US): joystick, botões e estado do display. Fica
+// fora do quadro para a resposta não esperar o próximo desenho.
+void input_task()
+{
+  uint64_t now = hal_time_us_64();
+  GestureEvent ev;
+  bool gesture = gesture_update(&joystick_gestures, mic_capture_aux(ADC_HORZ, JOYSTICK_AVERAGE),
+                                mic_capture_aux(ADC_VERT, JOYSTICK_AVERAGE), now, &ev);
+
+  // Qualquer entrada mantém o display aceso; a que acorda um display apagado é
+  // descartada, para não agir sobre uma tela que o usuário não via
+  bool moved = gesture || gesture_active(&joystick_gestures);
+  if (input_busy(&buttons) || moved)
+    if (power_input(&power, now))
+    {
+      input_discard(&buttons);
+      joystick_wake = moved;
+    }
+  if (joystick_wake)
+  {
+    joystick_wake = gesture_active(&joystick_gestures);
+    gesture = false;
   }
+  power_apply_display(power_display_target(&power, now));
+  test();
 
-  default:
+  // Sem resposta no prazo, a jornada interrompida é retomada (mesmo com alarme)
+  if (history_shift == FLASH_LOG_SHIFT_PENDING && now >= history_prompt_until_us)
+    history_choose(true);
+
+  // Com o alarme soando, o botão A o reconhece (a medição segue no núcleo 1) e as
+  // demais entradas são descartadas
+  InputEvent press;
+  if (alarm_state == ALARM_FIRING)
   {
-    const char *text[] = {
-        "MONITOR  SONORO",
-        "               ",
-        "Use o joystick ",
-        "para se mover  ",
-        "entre as telas ",
-        "e o pressione  ",
-        "para travar na ",
-        "tela atual     "};
+    while (input_next(&buttons, (uint32_t)now, &press))
+      if (press.pin == BTNA && press.kind != INPUT_LONG && alarm_state == ALARM_FIRING)
+        alarm_dispatch(ALARM_EV_ACK, NULL, false);
+    return;
+  }
 
-    const int num_lines = sizeof(text) / sizeof(text[0]);
-    memset(buf, 0, SSD1306_BUF_LEN);
-    show_text(text, num_lines, buf, &frame_area, false, 1000);
+  // Pergunta de retomada na tela: A retoma, B começa uma jornada nova
+  if (history_shift == FLASH_LOG_SHIFT_PENDING)
+  {
+    while (history_shift == FLASH_LOG_SHIFT_PENDING && input_next(&buttons, (uint32_t)now, &press))
+      if ((press.pin == BTNA || press.pin == BTNB) && press.kind != INPUT_LONG)
+        history_choose(press.pin == BTNA);
+    return;
   }
+
+  if (gesture)
+    joystick_navigate(&ev);
+  while (input_next(&buttons, (uint32_t)now, &press))
+    button_event(&press);
+}
+
+// Tarefa do histórico (HISTORY_PERIOD_US): um registro por minuto fechado pelo
+// núcleo 1. A gravação na flash fica fora do quadro e não para com o alarme.
+void history_task()
+{
+  if (meas.minute_count != logged_minutes)
+  {
+    logged_minutes = meas.minute_count;
+    history_log_minute();
   }
 }
 
-void calibrate_microphone() {
-  const uint32_t num_samples = 500;
-  uint32_t total = 0;
-  
-  // Amostra o ADC em condições silenciosas
-  for (int i = 0; i < num_samples; i++) {
-      total += read_adc(ADC_MIC);
-      sleep_us(100); // Pequeno intervalo entre amostras
+// Páginas da interface (pages.h). Cada uma desenha o quadro inteiro a partir do
+// retrato do núcleo 1 e dos ajustes; o envio ao display fica com ui_frame().
+
+// Ajuda: estática, desenhada uma vez e depois copiada do cache
+static uint8_t help_cache[SSD1306_BUF_LEN];
+
+void page_help_draw(uint8_t *buf)
+{
+  const char *text[] = {
+      "MONITOR  SONORO",
+      "               ",
+      "Joystick abre  ",
+      "uma tela; mesma",
+      "direcao volta. ",
+      "Segure ou use B",
+      "p/ fixar como  ",
+      "tela inicial.  "};
+
+  memset(buf, 0, SSD1306_BUF_LEN);
+  write_text(text, sizeof(text) / sizeof(text[0]), buf);
+}
+
+// Status: nível atual e projeção até 100% de dose no ritmo recente
+void page_status_draw(uint8_t *buf)
+{
+  char volume_str[30], tempo_str[30];
+  ExposureLimit limit = get_exposure_details(meas.intensity);
+  float projected = dose_projected_seconds(&meas.dose, dose_criterion);
+  TimeComponents tp = getTimeComponents(isinf(projected) ? 0.0 : projected);
+  // Com o ADC saturado o nível real é maior que o medido: "> " antes do valor
+  snprintf(volume_str, sizeof(volume_str), "  %s%.2f dB%c  ", over_range ? "> " : "  ", meas.intensity,
+           weighting_letter(meas.weighting));
+  snprintf(tempo_str, sizeof(tempo_str),   "  %3d h %02d min ", tp.hours, tp.minutes);
+
+  const char *text[] = {
+      "MONITOR  SONORO",
+      "               ",
+      " Status  Atual ",
+      limit.warning,
+      "  Intensidade  ",
+      volume_str,
+      " Dose  100% em ",
+      isinf(projected) ? "   ILIMITADO   " : tempo_str};
+
+  memset(buf, 0, SSD1306_BUF_LEN);
+  write_text(text, sizeof(text) / sizeof(text[0]), buf);
+}
+
+void page_graph_draw(uint8_t *buf)
+{
+  draw_level_graph(buf, graph_zoom);
+}
+
+void page_graph_select()
+{
+  graph_zoom = (graph_zoom + 1) % ENV_TIERS;
+}
+
+// Dose no critério escolhido (SEL troca entre NIOSH e OSHA)
+void page_dose_draw(uint8_t *buf)
+{
+  const DoseCriterion *crit = &dose_criteria[dose_criterion];
+  TimeComponents td = getTimeComponents(dose_duration_s(&meas.dose));
+  float projected = dose_projected_seconds(&meas.dose, dose_criterion);
+  TimeComponents tp = getTimeComponents(isinf(projected) ? 0.0 : projected);
+
+  char line1[30], line2[30], line3[30], line4[30];
+  snprintf(line1, sizeof(line1), "%-5s %2.0fdB/%.0fdB", crit->name, crit->criterion_db, crit->exchange_db);
+  snprintf(line2, sizeof(line2), "Dose: %7.1f %%", meas.dose.dose[dose_criterion] * 100.0f);
+  snprintf(line3, sizeof(line3), "Tempo %02d:%02d:%02d", td.hours, td.minutes, td.seconds);
+  snprintf(line4, sizeof(line4), "100%% em %3d:%02d", tp.hours, tp.minutes);
+
+  const char *text[] = {
+      " Dose de ruido ",
+      "               ",
+      line1,
+      line2,
+      line3,
+      "               ",
+      isinf(projected) ? "100% em   --:--" : line4,
+      " SEL: criterio "};
+  memset(buf, 0, SSD1306_BUF_LEN);
+  write_text(text, sizeof(text) / sizeof(text[0]), buf);
+}
+
+void page_dose_select()
+{
+  dose_criterion = (DoseCriterionId)((dose_criterion + 1) % DOSE_CRITERIA_COUNT);
+}
+
+// Resumo dos alarmes disparados
+void page_alarms_draw(uint8_t *buf)
+{
+  char line1[30], line2[30], line3[30];
+  char line4[30];
+  snprintf(line1, sizeof(line1), "Tempo Expo: %02d", alarmCountSafe);
+  snprintf(line2, sizeof(line2), "Vol Maximo: %02d", alarmCountMaxVolume);
+  snprintf(line3, sizeof(line3), "%s", lastAlarmReason);
+  snprintf(line4, sizeof(line4), "Fora Faixa: %02d", overRangeCount);
+  const char *text[] = {
+      " INFO  ALARMES ",
+      " QTD. Ativados ",
+      line1,
+      line2,
+      line4,
+      alarm_state_text(alarm_state),
+      "Ultimo  Motivo:",
+      line3};
+  memset(buf, 0, SSD1306_BUF_LEN);
+  write_text(text, sizeof(text) / sizeof(text[0]), buf);
+}
+
+// Estatísticas desde o último reset (SEL zera): a tela inteira é de números, o
+// título ficaria no lugar de um deles
+void page_stats_draw(uint8_t *buf)
+{
+  const StatsSummary *st = &meas.stats;
+  TimeComponents td = getTimeComponents((double)meas.stats_duration_samples / MIC_SAMPLE_RATE_HZ);
+  char line1[30], line2[30], line3[30], line4[30], line5[30], line6[30], line7[30], line8[30];
+  snprintf(line1, sizeof(line1), "Leq%c %6.1f dB", weighting_letter(meas.weighting), st->leq_cdb * 0.01f);
+  snprintf(line2, sizeof(line2), "Max  %6.1f dB", st->lmax_cdb * 0.01f);
+  snprintf(line3, sizeof(line3), "Min  %6.1f dB", st->lmin_cdb * 0.01f);
+  snprintf(line4, sizeof(line4), "L10  %6.1f dB", st->l10_cdb * 0.01f);
+  snprintf(line5, sizeof(line5), "L50  %6.1f dB", st->l50_cdb * 0.01f);
+  snprintf(line6, sizeof(line6), "L90  %6.1f dB", st->l90_cdb * 0.01f);
+  snprintf(line7, sizeof(line7), "LCpk %6.1f dB", meas.lcpeak_stats_cdb * 0.01f);
+  snprintf(line8, sizeof(line8), "Tempo %02d:%02d:%02d", td.hours, td.minutes, td.seconds);
+  const char *text[] = {line1, line2, line3, line4, line5, line6, line7, line8};
+  memset(buf, 0, SSD1306_BUF_LEN);
+  write_text(text, sizeof(text) / sizeof(text[0]), buf);
+}
+
+void page_stats_select()
+{
+  core1_send(CMD_RESET_STATS, 0);
+}
+
+void page_bands_draw(uint8_t *buf)
+{
+  draw_bands_page(buf, bands_octave_view);
+}
+
+void page_bands_select()
+{
+  bands_octave_view = !bands_octave_view;
+}
+
+// Tabela das páginas: id, desenho, intervalo mínimo entre redesenhos, dependências,
+// ação do SEL e cache. Um id desconhecido mostra a primeira (a ajuda).
+const PageDef ui_pages[] = {
+    {3, page_help_draw, 0, 0, NULL, help_cache},
+    {1, page_status_draw, 200000, PAGE_DEP_MEASUREMENT | PAGE_DEP_SETTINGS, cycle_weighting, NULL},
+    {2, page_graph_draw, 0, PAGE_DEP_HISTORY | PAGE_DEP_SETTINGS, page_graph_select, NULL},
+    {4, page_dose_draw, 1000000, PAGE_DEP_MEASUREMENT | PAGE_DEP_SETTINGS, page_dose_select, NULL},
+    {5, page_alarms_draw, 0, PAGE_DEP_ALARMS, NULL, NULL},
+    {PAGE_BANDS, page_bands_draw, 500000, PAGE_DEP_BANDS | PAGE_DEP_SETTINGS, page_bands_select, NULL},
+    {PAGE_STATS, page_stats_draw, 1000000, PAGE_DEP_MEASUREMENT | PAGE_DEP_SETTINGS, page_stats_select, NULL},
+};
+
+// Liga a análise de bandas do núcleo 1 só enquanto a página visível depende dela
+// (com a fila cheia, tenta de novo no próximo quadro)
+void ui_request_bands(bool on)
+{
+  static bool requested = false;
+  if (on != requested && core1_send(CMD_SET_BANDS, on))
+    requested = on;
+}
+
+// Um quadro da interface (UI_PERIOD_US): lê o retrato do núcleo 1, trata alarmes e
+// atualiza a página visível quando os dados dela mudaram
+void ui_frame()
+{
+  uint32_t frame_start = hal_time_us_32();
+  power_update_estimate(hal_time_us_64());
+
+  seqlock_read(&meas_lock, &meas, &meas_shared, sizeof(meas));
+  uint8_t page = ui_visible_page();
+  float intensity = meas.intensity;
+
+  // Dados novos para as páginas: um retrato novo traz também o Leq das bandas, e
+  // qualquer escrita no histórico muda a sequência de env_lock
+  static uint32_t seen_blocks = 0, seen_env = 0;
+  if (meas.blocks != seen_blocks)
+  {
+    seen_blocks = meas.blocks;
+    pages_touch(&ui_view, PAGE_DEP_MEASUREMENT | PAGE_DEP_BANDS);
   }
-  adc_baseline = (float)total / num_samples;
-  
-  // Feedback visual
-  gpio_put(LED_B, 1);
-  sleep_ms(200);
-  gpio_put(LED_B, 0);
+  if (env_lock.seq != seen_env)
+  {
+    seen_env = env_lock.seq;
+    pages_touch(&ui_view, PAGE_DEP_HISTORY);
+  }
+
+  telemetry_service();
+  history_dump_service();
+
+  // Enquanto o núcleo 1 não confirmar o último zeramento, a dose do retrato
+  // ainda é a antiga e não pode disparar alarme de exposição
+  bool exposure_current = meas.exposure_epoch == exposure_epoch_requested;
+
+  // Prioriza o alarme de volume máximo (nível ou pico em C) e depois a dose de 100%
+  // no critério escolhido. O pico é um evento: qualquer bloco acima do limite desde o
+  // último quadro dispara, mesmo que o retrato dele não tenha sido lido.
+  static char dose_reason[16];
+  const char *reason = NULL;
+  bool max_volume = false;
+  bool peak_event = meas.peak_alarm_blocks != peak_alarm_seen;
+  peak_alarm_seen = meas.peak_alarm_blocks;
+
+  // Saturação: indicação e contagem próprias, não é o limite de pico
+  uint64_t now_us = hal_time_us_64();
+  if (meas.over_range_blocks != over_range_seen)
+  {
+    over_range_seen = meas.over_range_blocks;
+    if (!over_range)
+      overRangeCount++;
+    over_range_until_us = now_us + OVER_RANGE_HOLD_US;
+  }
+  bool was_over_range = over_range;
+  over_range = now_us < over_range_until_us;
+  if (over_range != was_over_range)
+    pages_touch(&ui_view, PAGE_DEP_ALARMS | PAGE_DEP_MEASUREMENT);
+  if (intensity >= MAX_VOLUME_THRESHOLD)
+  {
+    reason = "VolMax excedido";
+    max_volume = true;
+  }
+  else if (peak_event)
+  {
+    reason = "Pico C excedido";
+    max_volume = true;
+  }
+  else if (exposure_current && meas.dose.dose[dose_criterion] >= 1.0f)
+  {
+    snprintf(dose_reason, sizeof(dose_reason), "Dose 100%% %s", dose_criteria[dose_criterion].name);
+    reason = dose_reason;
+  }
+  alarm_dispatch(reason ? ALARM_EV_TRIGGER : ALARM_EV_CLEAR, reason, max_volume);
+
+  // A tela de alarme foi desenhada uma vez na transição e fica até o reconhecimento
+  if (alarm_state == ALARM_FIRING)
+  {
+    history_prompt_shown_s = -1; // Cobriu a pergunta de retomada, se houver
+    return;
+  }
+  if (history_shift == FLASH_LOG_SHIFT_PENDING)
+  {
+    history_prompt_frame();
+    ui_frame_us = hal_time_us_32() - frame_start;
+    return;
+  }
+  find_led(intensity);
+
+  power_apply_clock();
+
+  // Display apagado: nada a desenhar nem a enviar (nem bandas a calcular)
+  if (power.display == POWER_DISPLAY_OFF)
+  {
+    ui_request_bands(false);
+    ui_frame_us = hal_time_us_32() - frame_start;
+    return;
+  }
+
+  // Só a página visível é atualizada, e só quando algo que ela mostra mudou
+  ui_request_bands(pages_deps(&ui_view, page) & PAGE_DEP_BANDS);
+  if (pages_frame(&ui_view, page, hal_time_us_64(), buf))
+    render(buf, &frame_area);
+
+  ui_frame_us = hal_time_us_32() - frame_start;
 }
 
-void test()
+#ifdef SIMIS_BENCHMARK
+// Casos do benchmark (bench.h): os trechos que rodam a cada bloco de áudio ou a
+// cada quadro. O setup de cada caso prepara o estado fora da medição.
+static uint32_t bench_seed = 12345;
+static uint16_t bench_block[ACQ_BLOCK_SAMPLES];
+static volatile float bench_sink_f;
+static volatile int32_t bench_sink_i;
+
+// Energias variadas, como as de um bloco real
+static void bench_setup_energy()
+{
+  bench_seed = bench_seed * 1664525u + 1013904223u;
+  mic_energy = ((uint64_t)bench_seed << 8) | 1;
+  mic_sample_count = ACQ_BLOCK_SAMPLES;
+}
+
+static void bench_mic_power()
+{
+  bench_sink_f = mic_power();
+}
+
+static void bench_get_intensity()
+{
+  bench_sink_f = get_intensity((float)(bench_seed >> 8) * (1.0f / 65536.0f) + 0.001f);
+}
+
+static void bench_db_float()
+{
+  bench_sink_f = get_intensity(mic_power());
+}
+
+static void bench_db_fixed()
 {
-  if (gpio_get(SEL_PIN) == 0)
+  bench_sink_i = mic_level_cdb();
+}
+
+// Um bloco inteiro de amostras: ponderação, bandas e energia
+static void bench_setup_block()
+{
+  for (int i = 0; i < ACQ_BLOCK_SAMPLES; i++)
   {
-    elapsed97 += 300;
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    bench_block[i] = (uint16_t)(2047 + (int)(bench_seed >> 22) - 512);
   }
-  return;
 }
 
-int main()
+static void bench_block_ready()
+{
+  mic_block_ready(bench_block, ACQ_BLOCK_SAMPLES);
+}
+
+static void bench_setup_clear()
+{
+  memset(buf, 0, SSD1306_BUF_LEN);
+}
+
+// Uma linha cheia de texto, alinhada à página, fora dela e na fonte proporcional
+static void bench_write_string()
+{
+  WriteString(buf, 5, 8, "MONITOR  SONORO");
+}
+
+static void bench_write_string_y3()
+{
+  WriteString(buf, 5, 11, "MONITOR  SONORO");
+}
+
+static void bench_write_string_prop()
+{
+  WriteStringProp(buf, 0, 11, "Leq 71.3 dB  Pico 84.0 dB");
+}
+
+static void bench_draw_line()
 {
-  last_time = time_us_64();
-  stdio_init_all();
+  DrawLine(buf, 0, SSD1306_HEIGHT - 1, SSD1306_WIDTH - 1, 0, true);
+}
+
+// As barras da página de bandas: 22 medidores de 4x48 pixels
+static void bench_bar_meters()
+{
+  for (int b = 0; b < BANDS_THIRD_COUNT; b++)
+    DrawBarMeter(buf, 9 + b * 5, 16, 4, 48, (b * 7) % 48);
+}
+
+// Quadro inteiro diferente do anterior (pior caso do render_diff); a transferência
+// anterior termina fora da medição, então mede-se só a CPU
+static void bench_setup_render()
+{
+  SSD1306_tx_flush();
+  static uint8_t pattern = 0x55;
+  pattern ^= 0xFF;
+  memset(buf, pattern, SSD1306_BUF_LEN);
+}
+
+static void bench_render()
+{
+  render(buf, &frame_area);
+}
+
+// Quadro com a página redesenhada (pior caso); o caso ui_frame_idle mede o quadro
+// sem nada novo para a página, que não desenha nem envia nada
+static void bench_setup_frame()
+{
+  SSD1306_tx_flush();
+  pages_invalidate(&ui_view);
+}
+
+static void bench_level_graph()
+{
+  draw_level_graph(buf, 0);
+}
+
+static const BenchCase bench_cases[] = {
+    {"mic_power", bench_setup_energy, bench_mic_power},
+    {"get_intensity", bench_setup_energy, bench_get_intensity},
+    {"db_float", bench_setup_energy, bench_db_float},
+    {"db_fixed", bench_setup_energy, bench_db_fixed},
+    {"mic_block_ready", bench_setup_block, bench_block_ready},
+    {"WriteString", bench_setup_clear, bench_write_string},
+    {"WriteString_y3", bench_setup_clear, bench_write_string_y3},
+    {"WriteStringProp", bench_setup_clear, bench_write_string_prop},
+    {"DrawLine", bench_setup_clear, bench_draw_line},
+    {"DrawBarMeter", bench_setup_clear, bench_bar_meters},
+    {"render", bench_setup_render, bench_render},
+    {"draw_level_graph", NULL, bench_level_graph},
+    {"ui_frame", bench_setup_frame, ui_frame},
+    {"ui_frame_idle", NULL, ui_frame},
+};
+
+// Roda a suíte antes de o núcleo 1 começar (usa o estado dele), com a página do gráfico (a que mais
+// desenha) no lugar da tela extra
+void benchmark_suite(const char *filter, uint32_t iterations, bool json)
+{
+  hal_cycles_start();
+  set_weighting(mic_weighting_type); // Filtro pronto, como no núcleo 1
+  for (int i = 0; i < ENV_COLUMNS; i++) // Histórico cheio (o núcleo 1 ainda não começou)
+  {
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    int16_t base = 5000 + (int16_t)(bench_seed >> 20);
+    env_shared[0].cols[i] = {base, (int16_t)(base + 1500), (int16_t)(base + 600)};
+  }
+  env_shared[0].head = 2 * ENV_COLUMNS;
+  uint8_t page = saved_page;
+  saved_page = 2;
+  bool low_power = power.low_power;
+  power.low_power = false; // Sem troca de relógio nem display apagado durante as medições
+  bands_enabled = true;    // O bloco de áudio com a análise de bandas ligada
+  bench_run_all(bench_cases, count_of(bench_cases), filter, iterations, json);
+  bands_enabled = false;
+  power.low_power = low_power;
+  saved_page = page;
+  memset(&env_shared[0], 0, sizeof(env_shared[0]));
+  mic_energy = 0;
+  mic_sample_count = 0;
+}
+#endif
+
+// Períodos das tarefas do núcleo 0; o prazo de cada uma é o próprio período. A
+// interface pode ir de 10 Hz a 30 Hz (33333 us) sem mudar o resto.
+#ifndef UI_PERIOD_US
+#define UI_PERIOD_US 100000
+#endif
+#define INPUT_PERIOD_US 20000    // 50 Hz
+#define HISTORY_PERIOD_US 1000000 // 1 Hz
+
+SchedTask core0_tasks[CORE0_TASKS] = {
+    {"input", input_task, INPUT_PERIOD_US},
+    {"ui", ui_frame, UI_PERIOD_US},
+    {"history", history_task, HISTORY_PERIOD_US},
+};
+
+// Inicialização do núcleo 0, antes de o núcleo 1 começar
+void setup()
+{
+  hal_serial_init();
   config_pins();
   init_i2c();
   init_display();
-  adc_init();
-  calibrate_microphone();
-  calculate_safe_values();
+  dose_init(); // Tabela de dose pronta antes de o núcleo 1 começar a medir
+  history_init();
+  power_init(&power, POWER_LOW_DEFAULT, hal_sys_clock_khz(), hal_time_us_64());
+  gesture_init(&joystick_gestures);
+  pages_init(&ui_view, ui_pages, count_of(ui_pages), SSD1306_BUF_LEN);
+  sched_init(&core0_sched, core0_tasks, CORE0_TASKS, hal_time_us_64, hal_time_us_64());
+}
+
+// Um passo do núcleo 0: roda a tarefa mais urgente, se houver. Retorna quanto o
+// laço principal pode dormir até a próxima liberação.
+uint32_t loop()
+{
+  return sched_step(&core0_sched);
+}
+
+// No host o simulador (sim/simis_sim.cpp) tem o próprio main e alterna os dois
+// núcleos no relógio virtual
+#ifndef SIMIS_HOST
+int main()
+{
+  setup();
+#ifdef SIMIS_BENCHMARK
+  // Espera até 10 s por um terminal na USB para o relatório não se perder
+  for (int i = 0; i < 100 && !hal_serial_connected(); i++)
+    hal_sleep_ms(100);
+  benchmark_suite(NULL, BENCH_DEFAULT_ITERATIONS, true);
+#endif
+  hal_core1_launch(core1_entry); // Aquisição no núcleo 1, interface neste
 
   while (true)
   {
-    loop_display();
-    test();
-    sleep_ms(100);
+    uint32_t idle_us = loop();
+    if (idle_us)
+      hal_sleep_us(idle_us);
   }
 
   return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
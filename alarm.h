@@ -0,0 +1,66 @@
+// Máquina de estados do alarme, sem bloqueio e sem dependência de hardware.
+//
+// O laço principal gera um evento por tick (condição presente ou ausente) e um
+// evento de reconhecimento quando o botão A é pressionado com o alarme soando.
+// alarm_next() só consulta a tabela de transições; as ações de entrada em cada
+// estado (desenhar a tela, tocar ou parar a melodia, zerar a exposição) ficam com
+// quem chama, uma única vez por transição.
+//
+//   OCIOSO       --condição-->      DISPARADO    (tela de alarme + melodia em laço)
+//   DISPARADO    --reconhecer-->    RECONHECIDO  (melodia para, exposição zerada)
+//   RECONHECIDO  --sem condição-->  REARMADO     (a condição que disparou acabou)
+//   REARMADO     --condição-->      DISPARADO
+//
+// Em RECONHECIDO a condição ainda presente não dispara de novo, para não repetir o
+// alarme enquanto ela persistir. Em DISPARADO o alarme fica travado até o
+// reconhecimento, mesmo que a condição desapareça.
+
+#include <stdint.h>
+
+typedef enum
+{
+  ALARM_IDLE = 0,
+  ALARM_FIRING,
+  ALARM_ACKNOWLEDGED,
+  ALARM_REARMED,
+  ALARM_STATE_COUNT
+} AlarmState;
+
+typedef enum
+{
+  ALARM_EV_CLEAR = 0, // Nenhuma condição de alarme neste tick
+  ALARM_EV_TRIGGER,   // Alguma condição de alarme presente neste tick
+  ALARM_EV_ACK,       // Usuário reconheceu o alarme
+  ALARM_EV_COUNT
+} AlarmEvent;
+
+static const uint8_t alarm_transitions[ALARM_STATE_COUNT][ALARM_EV_COUNT] = {
+    //                    CLEAR          TRIGGER             ACK
+    /* IDLE         */ {ALARM_IDLE, ALARM_FIRING, ALARM_IDLE},
+    /* FIRING       */ {ALARM_FIRING, ALARM_FIRING, ALARM_ACKNOWLEDGED},
+    /* ACKNOWLEDGED */ {ALARM_REARMED, ALARM_ACKNOWLEDGED, ALARM_ACKNOWLEDGED},
+    /* REARMED      */ {ALARM_REARMED, ALARM_FIRING, ALARM_REARMED},
+};
+
+static inline AlarmState alarm_next(AlarmState state, AlarmEvent event)
+{
+  if (state >= ALARM_STATE_COUNT || event >= ALARM_EV_COUNT)
+    return state;
+  return (AlarmState)alarm_transitions[state][event];
+}
+
+// Texto de 15 colunas para o display
+static inline const char *alarm_state_text(AlarmState state)
+{
+  switch (state)
+  {
+  case ALARM_FIRING:
+    return "Estado: Ativo  ";
+  case ALARM_ACKNOWLEDGED:
+    return "Estado: Reconh.";
+  case ALARM_REARMED:
+    return "Estado:Rearmado";
+  default:
+    return "Estado: Ocioso ";
+  }
+}
@@ -0,0 +1,245 @@
+// Analisador de bandas de oitava e de terço de oitava (63 Hz a 8 kHz).
+//
+// Janelas de BANDS_FFT_SIZE amostras do microfone (sem ponderação) passam por uma
+// FFT real em ponto fixo: a sequência real de 2048 pontos é empacotada em uma FFT
+// complexa de 1024 pontos (Q15, radix-2) com ponto flutuante em bloco, e depois
+// separada. A energia de cada bin entra na banda que contém sua frequência central
+// e o Leq de cada banda é a média de energia de todas as janelas analisadas.
+//
+// A memória é fixa (~10 KB) e bands_service() analisa no máximo uma janela por
+// chamada (~2 ms no Cortex-M0+). Enquanto uma janela espera análise, as amostras
+// novas são ignoradas, então o Leq por banda é estimado sobre as janelas analisadas.
+//
+// A resolução é de fs / 2048 = 15.6 Hz; nas bandas de terço mais graves (63 e 80 Hz)
+// só há um ou dois bins e o vazamento da janela de Hann entre bandas vizinhas é maior.
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#define BANDS_FFT_BITS 11
+#define BANDS_FFT_SIZE (1 << BANDS_FFT_BITS)  // Pontos reais por janela
+#define BANDS_CPLX_SIZE (BANDS_FFT_SIZE / 2) // Pontos da FFT complexa
+
+#define BANDS_THIRD_COUNT 22  // Terços de oitava: 63 Hz .. 8 kHz
+#define BANDS_OCTAVE_COUNT 8  // Oitavas: 63 Hz .. 8 kHz
+#define BANDS_THIRD_FIRST -12 // Índice do primeiro terço (1000 * 10^(k/10) Hz)
+
+static int16_t bands_re[BANDS_CPLX_SIZE]; // Amostras pares / parte real
+static int16_t bands_im[BANDS_CPLX_SIZE]; // Amostras ímpares / parte imaginária
+static int16_t bands_cos[BANDS_CPLX_SIZE]; // cos(pi k / 1024) em Q15
+static int16_t bands_sin[BANDS_CPLX_SIZE]; // sin(pi k / 1024) em Q15
+static int16_t bands_window[BANDS_FFT_SIZE / 2 + 1]; // Metade da janela de Hann (Q15)
+
+// Primeiro bin de cada banda; a banda i vai de first[i] até first[i + 1] - 1
+static uint16_t bands_third_bin[BANDS_THIRD_COUNT + 1];
+static uint16_t bands_octave_bin[BANDS_OCTAVE_COUNT + 1];
+
+static volatile uint16_t bands_fill = 0; // Amostras na janela; BANDS_FFT_SIZE = pronta
+
+typedef struct
+{
+  double third_energy[BANDS_THIRD_COUNT];   // Soma das médias quadráticas por janela
+  double octave_energy[BANDS_OCTAVE_COUNT];
+  uint32_t windows;                         // Janelas analisadas
+} BandsState;
+
+static BandsState bands_state;
+
+// Frequência central nominal (base 10) do terço de índice k
+static inline float bands_third_center(int band)
+{
+  return 1000.0f * powf(10.0f, (BANDS_THIRD_FIRST + band) / 10.0f);
+}
+
+static inline float bands_octave_center(int band)
+{
+  return 1000.0f * powf(10.0f, (BANDS_THIRD_FIRST + 3 * band) / 10.0f);
+}
+
+static uint16_t bands_edge_bin(float freq, float bin_hz)
+{
+  return (uint16_t)ceilf(freq / bin_hz);
+}
+
+void bands_reset()
+{
+  memset(&bands_state, 0, sizeof(bands_state));
+}
+
+void bands_init(uint32_t sample_rate)
+{
+  for (int k = 0; k < BANDS_CPLX_SIZE; k++)
+  {
+    bands_cos[k] = (int16_t)lroundf(32767.0f * cosf((float)M_PI * k / BANDS_CPLX_SIZE));
+    bands_sin[k] = (int16_t)lroundf(32767.0f * sinf((float)M_PI * k / BANDS_CPLX_SIZE));
+  }
+  for (int n = 0; n <= BANDS_FFT_SIZE / 2; n++)
+    bands_window[n] = (int16_t)lroundf(32767.0f * 0.5f * (1.0f - cosf(2.0f * (float)M_PI * n / BANDS_FFT_SIZE)));
+
+  const float bin_hz = (float)sample_rate / BANDS_FFT_SIZE;
+  const float half_third = powf(10.0f, 1.0f / 20.0f);
+  const float half_octave = powf(10.0f, 3.0f / 20.0f);
+  for (int i = 0; i < BANDS_THIRD_COUNT; i++)
+    bands_third_bin[i] = bands_edge_bin(bands_third_center(i) / half_third, bin_hz);
+  bands_third_bin[BANDS_THIRD_COUNT] = bands_edge_bin(bands_third_center(BANDS_THIRD_COUNT - 1) * half_third, bin_hz);
+  for (int i = 0; i < BANDS_OCTAVE_COUNT; i++)
+    bands_octave_bin[i] = bands_edge_bin(bands_octave_center(i) / half_octave, bin_hz);
+  bands_octave_bin[BANDS_OCTAVE_COUNT] = bands_edge_bin(bands_octave_center(BANDS_OCTAVE_COUNT - 1) * half_octave, bin_hz);
+
+  bands_reset();
+  bands_fill = 0;
+}
+
+// Acrescenta uma amostra (contagens do ADC sem a baseline) à janela em preenchimento
+static inline void bands_push(int16_t x)
+{
+  uint16_t n = bands_fill;
+  if (n >= BANDS_FFT_SIZE)
+    return;
+  if (n & 1)
+    bands_im[n >> 1] = x;
+  else
+    bands_re[n >> 1] = x;
+  bands_fill = n + 1;
+}
+
+// Descarta a janela em preenchimento ou à espera de análise (as amostras deixaram de
+// ser contínuas, por exemplo depois de uma pausa da análise)
+static inline void bands_discard_window()
+{
+  bands_fill = 0;
+}
+
+// OU dos módulos: limite superior barato (menor que 2x) para o maior valor da janela
+static int32_t bands_peak()
+{
+  int32_t peak = 0;
+  for (int i = 0; i < BANDS_CPLX_SIZE; i++)
+    peak |= (bands_re[i] < 0 ? -bands_re[i] : bands_re[i]) | (bands_im[i] < 0 ? -bands_im[i] : bands_im[i]);
+  return peak;
+}
+
+// Desloca toda a janela um bit à direita se algum valor puder estourar no próximo estágio
+static int bands_block_scale()
+{
+  int32_t peak = bands_peak();
+  if (peak < 8192) // Uma borboleta cresce no máximo 1 + sqrt(2) vezes
+    return 0;
+  for (int i = 0; i < BANDS_CPLX_SIZE; i++)
+  {
+    bands_re[i] >>= 1;
+    bands_im[i] >>= 1;
+  }
+  return 1;
+}
+
+// FFT complexa radix-2 in-place; retorna quantos bits de escala foram aplicados
+static int bands_fft()
+{
+  for (int i = 1, j = 0; i < BANDS_CPLX_SIZE; i++)
+  {
+    int bit = BANDS_CPLX_SIZE >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j)
+    {
+      int16_t t = bands_re[i]; bands_re[i] = bands_re[j]; bands_re[j] = t;
+      t = bands_im[i]; bands_im[i] = bands_im[j]; bands_im[j] = t;
+    }
+  }
+
+  int scale = 0;
+  for (int size = 2; size <= BANDS_CPLX_SIZE; size <<= 1)
+  {
+    scale += bands_block_scale();
+    int half = size >> 1;
+    int step = (2 * BANDS_CPLX_SIZE) / size; // Passo na tabela de pi k / 1024
+    for (int j = 0; j < half; j++)
+    {
+      int32_t wr = bands_cos[j * step];
+      int32_t wi = -bands_sin[j * step];
+      for (int k = j; k < BANDS_CPLX_SIZE; k += size)
+      {
+        int l = k + half;
+        int32_t tr = (wr * bands_re[l] - wi * bands_im[l]) >> 15;
+        int32_t ti = (wr * bands_im[l] + wi * bands_re[l]) >> 15;
+        bands_re[l] = (int16_t)(bands_re[k] - tr);
+        bands_im[l] = (int16_t)(bands_im[k] - ti);
+        bands_re[k] = (int16_t)(bands_re[k] + tr);
+        bands_im[k] = (int16_t)(bands_im[k] + ti);
+      }
+    }
+  }
+  return scale;
+}
+
+// |X[k]|^2 / 2 do espectro real de 2048 pontos, a partir da FFT complexa empacotada
+static inline uint32_t bands_bin_power(int k)
+{
+  int32_t zr = bands_re[k], zi = bands_im[k];
+  int32_t cr = bands_re[BANDS_CPLX_SIZE - k], ci = -bands_im[BANDS_CPLX_SIZE - k];
+  int32_t fer = (zr + cr) >> 1, fei = (zi + ci) >> 1; // Parte par
+  int32_t odr = (zi - ci) >> 1, odi = (cr - zr) >> 1;  // Parte ímpar
+  int32_t c = bands_cos[k], s = bands_sin[k];
+  int32_t xr = fer + ((c * odr + s * odi) >> 15);
+  int32_t xi = fei + ((c * odi - s * odr) >> 15);
+  uint32_t ar = (uint32_t)(xr < 0 ? -xr : xr), ai = (uint32_t)(xi < 0 ? -xi : xi);
+  return ((ar * ar) >> 1) + ((ai * ai) >> 1);
+}
+
+// Analisa a janela pronta, se houver. Retorna true se uma janela foi processada.
+bool bands_service()
+{
+  if (bands_fill < BANDS_FFT_SIZE)
+    return false;
+
+  // Normaliza a janela para usar a faixa do Q15 e aplica a janela de Hann
+  int32_t peak = bands_peak() | 1;
+  int shift = 0;
+  while ((peak << (shift + 1)) < 8192)
+    shift++;
+  for (int i = 0; i < BANDS_CPLX_SIZE; i++)
+  {
+    int n = 2 * i;
+    int32_t w0 = bands_window[n <= BANDS_FFT_SIZE / 2 ? n : BANDS_FFT_SIZE - n];
+    int32_t w1 = bands_window[n + 1 <= BANDS_FFT_SIZE / 2 ? n + 1 : BANDS_FFT_SIZE - n - 1];
+    bands_re[i] = (int16_t)(((int32_t)bands_re[i] << shift) * w0 >> 15);
+    bands_im[i] = (int16_t)(((int32_t)bands_im[i] << shift) * w1 >> 15);
+  }
+
+  int scale = bands_fft();
+
+  // Média quadrática da banda: 2 * sum|X|^2 / (L^2 * 3/8) para a janela de Hann
+  // (bands_bin_power já divide por 2), desfazendo a normalização e a escala em bloco
+  const float norm = ldexpf(2.0f * 16.0f / 3.0f, 2 * (scale - shift) - 2 * BANDS_FFT_BITS);
+
+  uint64_t third[BANDS_THIRD_COUNT] = {0};
+  for (int b = 0; b < BANDS_THIRD_COUNT; b++)
+    for (int k = bands_third_bin[b]; k < bands_third_bin[b + 1]; k++)
+      third[b] += bands_bin_power(k);
+  for (int b = 0; b < BANDS_THIRD_COUNT; b++)
+    bands_state.third_energy[b] += (float)third[b] * norm;
+
+  for (int b = 0; b < BANDS_OCTAVE_COUNT; b++)
+  {
+    uint64_t sum = 0;
+    for (int k = bands_octave_bin[b]; k < bands_octave_bin[b + 1]; k++)
+      sum += bands_bin_power(k);
+    bands_state.octave_energy[b] += (float)sum * norm;
+  }
+
+  bands_state.windows++;
+  bands_fill = 0; // Libera a janela para novas amostras
+  return true;
+}
+
+// Média quadrática (contagens^2) da banda desde o último bands_reset()
+float bands_mean_square(bool octave, int band)
+{
+  if (bands_state.windows == 0)
+    return 0.0f;
+  double e = octave ? bands_state.octave_energy[band] : bands_state.third_energy[band];
+  return (float)(e / bands_state.windows);
+}
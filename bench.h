@@ -0,0 +1,127 @@
+// Microbenchmarks dos trechos críticos (compilado só com SIMIS_BENCHMARK).
+//
+// Cada caso roda N vezes e cada execução é medida isoladamente com hal_cycles()
+// (ciclos do processador no RP2040, nanossegundos no host), já descontado o custo
+// da própria medição. O preparo de cada execução (setup) fica fora da medição.
+// O relatório traz mínimo, mediana, p99 e média, em JSON (para comparar versões do
+// firmware) ou em tabela no estilo do Google Benchmark.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_DEFAULT_ITERATIONS 256
+#define BENCH_MAX_ITERATIONS 1024
+
+typedef struct
+{
+  const char *name;
+  void (*setup)(); // Antes de cada execução, fora da medição (pode ser NULL)
+  void (*run)();
+} BenchCase;
+
+typedef struct
+{
+  uint32_t iterations;
+  uint32_t min, median, p99;
+  float mean;
+} BenchResult;
+
+static uint32_t bench_samples[BENCH_MAX_ITERATIONS];
+static uint32_t bench_overhead = 0;
+
+static int bench_compare(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return x < y ? -1 : x > y;
+}
+
+static void bench_nothing()
+{
+}
+
+static uint32_t bench_time_once(const BenchCase *c)
+{
+  if (c->setup)
+    c->setup();
+  uint32_t t0 = hal_cycles();
+  c->run();
+  uint32_t t1 = hal_cycles();
+  return (t1 - t0) & HAL_CYCLES_MASK;
+}
+
+// Roda um caso e calcula as estatísticas
+void bench_measure(const BenchCase *c, uint32_t iterations, BenchResult *r)
+{
+  if (iterations > BENCH_MAX_ITERATIONS)
+    iterations = BENCH_MAX_ITERATIONS;
+  if (iterations == 0)
+    iterations = 1;
+
+  c->run(); // Aquece caches e estado inicial
+  uint64_t sum = 0;
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    uint32_t t = bench_time_once(c);
+    t = t > bench_overhead ? t - bench_overhead : 0;
+    bench_samples[i] = t;
+    sum += t;
+  }
+  qsort(bench_samples, iterations, sizeof(bench_samples[0]), bench_compare);
+
+  r->iterations = iterations;
+  r->min = bench_samples[0];
+  r->median = bench_samples[iterations / 2];
+  r->p99 = bench_samples[(iterations * 99 + 99) / 100 - 1];
+  r->mean = (float)sum / iterations;
+}
+
+// Custo de medir uma função vazia (o menor de várias medições)
+void bench_calibrate()
+{
+  BenchCase empty = {"overhead", NULL, bench_nothing};
+  bench_overhead = 0;
+  uint32_t best = UINT32_MAX;
+  for (int i = 0; i < 64; i++)
+  {
+    uint32_t t = bench_time_once(&empty);
+    if (t < best)
+      best = t;
+  }
+  bench_overhead = best;
+}
+
+// Roda os casos cujo nome contém filter (NULL = todos) e imprime o relatório
+void bench_run_all(const BenchCase *cases, int count, const char *filter, uint32_t iterations, bool json)
+{
+  bench_calibrate();
+
+  if (json)
+    printf("{\n  \"context\": {\"target\": \"%s\", \"unit\": \"%s\", \"counter_hz\": %lu, \"overhead\": %lu},\n  \"benchmarks\": [",
+           HAL_TARGET_NAME, HAL_CYCLES_UNIT, (unsigned long)hal_cycles_hz(), (unsigned long)bench_overhead);
+  else
+    printf("%-24s %12s %12s %12s %10s\n%s\n", "Benchmark", "Min", "Median", "P99", "Iterations",
+           "------------------------------------------------------------------------");
+
+  bool first = true;
+  for (int i = 0; i < count; i++)
+  {
+    if (filter && !strstr(cases[i].name, filter))
+      continue;
+
+    BenchResult r;
+    bench_measure(&cases[i], iterations, &r);
+    if (json)
+      printf("%s\n    {\"name\": \"%s\", \"iterations\": %lu, \"min\": %lu, \"median\": %lu, \"p99\": %lu, \"mean\": %.1f}",
+             first ? "" : ",", cases[i].name, (unsigned long)r.iterations, (unsigned long)r.min,
+             (unsigned long)r.median, (unsigned long)r.p99, r.mean);
+    else
+      printf("%-24s %9lu %-2s %9lu %-2s %9lu %-2s %10lu\n", cases[i].name, (unsigned long)r.min, HAL_CYCLES_UNIT_SHORT,
+             (unsigned long)r.median, HAL_CYCLES_UNIT_SHORT, (unsigned long)r.p99, HAL_CYCLES_UNIT_SHORT,
+             (unsigned long)r.iterations);
+    first = false;
+  }
+
+  if (json)
+    printf("\n  ]\n}\n");
+}
@@ -0,0 +1,49 @@
+// Bloqueio de DC do microfone em ponto fixo, contínuo.
+//
+// A linha de base (polarização do microfone) é uma média exponencial das amostras,
+// baseline += (x - baseline) / 2^DC_BLOCK_SHIFT, e a saída é x - baseline: um
+// passa-altas de um polo com corte em fs / (2 pi 2^DC_BLOCK_SHIFT), 0.3 Hz a 32 kHz,
+// bem abaixo da banda das ponderações. Ela acompanha a deriva com a temperatura ao
+// longo do turno, sem depender de silêncio na inicialização: a primeira amostra
+// serve de ponto de partida e a constante de tempo é de 0.5 s.
+//
+// A base fica em Q19 relativa ao meio da escala do ADC de 12 bits, então x - baseline
+// cabe em 32 bits (4095 << 19 < 2^31) e o passo mínimo é 1/32 de contagem.
+
+#include <stdint.h>
+
+#define DC_BLOCK_FRAC 19
+#define DC_BLOCK_SHIFT 14
+#define DC_BLOCK_MID 2048
+
+typedef struct
+{
+  int32_t baseline; // Q19, relativa a DC_BLOCK_MID
+  bool primed;
+} DcBlocker;
+
+static inline void dc_block_init(DcBlocker *f)
+{
+  f->baseline = 0;
+  f->primed = false;
+}
+
+// Uma amostra bruta do ADC; devolve a amostra sem DC em Q4 (1/16 de contagem)
+static inline int32_t dc_block_run(DcBlocker *f, uint16_t sample)
+{
+  int32_t x = ((int32_t)sample - DC_BLOCK_MID) << DC_BLOCK_FRAC;
+  if (!f->primed)
+  {
+    f->baseline = x;
+    f->primed = true;
+  }
+  int32_t d = x - f->baseline;
+  f->baseline += (d + (1 << (DC_BLOCK_SHIFT - 1))) >> DC_BLOCK_SHIFT; // Arredondado: sem viés
+  return d >> (DC_BLOCK_FRAC - 4);
+}
+
+// Estimativa atual da polarização, em contagens Q4 do ADC
+static inline int32_t dc_block_baseline_q4(const DcBlocker *f)
+{
+  return (DC_BLOCK_MID << 4) + (f->baseline >> (DC_BLOCK_FRAC - 4));
+}
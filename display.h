@@ -1,4 +1,5 @@
 #include <cstring>
+#include <cassert>
 
 #define SSD1306_HEIGHT 64
 #define SSD1306_WIDTH  128
@@ -54,42 +55,115 @@ struct render_area {
     int buflen;
 };
 
+// Bytes pushed over I2C (control bytes included), to measure what each frame costs
+struct render_stats {
+    uint32_t frames;        // frames that went through render_diff()
+    uint32_t last_bytes;    // bytes sent for the last frame
+    uint32_t last_windows;  // windows (col/page rectangles) sent for the last frame
+    uint64_t total_bytes;   // bytes sent since boot, including init and images
+    uint32_t tx_errors;     // transfers aborted by timeout or by the I2C controller
+    uint32_t last_wait_us;  // time the last frame waited for the previous transfer
+};
+
+struct render_stats ssd1306_stats = {};
+
+// Copy of what the display RAM currently holds, used to send only what changed
+static uint8_t ssd1306_shadow[SSD1306_BUF_LEN];
+static bool ssd1306_shadow_valid = false;
+
+// Rough I2C cost of opening a window (address commands) in bytes. Two dirty pages
+// next to each other are sent as one window when that wastes fewer bytes than this.
+#define SSD1306_WINDOW_OVERHEAD 14
+
 void calc_render_area_buflen(struct render_area *area) {
     // calculate how long the flattened buffer will be for a render area
     area->buflen = (area->end_col - area->start_col + 1) * (area->end_page - area->start_page + 1);
 }
 
-#ifdef i2c_default
+// Everything sent to the display goes through a stream of words handed to the HAL
+// I2C stream (hal.h): the low byte is the data, and HAL_I2C_STOP closes a
+// transaction, so one transfer can carry several transactions (batched commands
+// followed by the data windows). There are two stream buffers: one is in flight
+// while the next frame is being queued into the other, and no heap is used.
+#define SSD1306_TX_WORDS ((int)(SSD1306_BUF_LEN + SSD1306_NUM_PAGES * 16))
 
-void SSD1306_send_cmd(uint8_t cmd) {
-    // I2C write process expects a control byte followed by data
-    // this "data" can be a command or data to follow up a command
-    // Co = 1, D/C = 0 => the driver expects a command
-    uint8_t buf[2] = {0x80, cmd};
-    i2c_write_blocking(i2c1, SSD1306_I2C_ADDR, buf, 2, false);
+// Upper bound for one transfer; a full frame takes ~25 ms at 400 kHz. When it runs
+// out the transfer is aborted, so a stuck bus cannot hang the caller.
+#define SSD1306_TX_TIMEOUT_US 60000
+
+static uint16_t ssd1306_tx[2][SSD1306_TX_WORDS];
+static int ssd1306_tx_fill = 0; // buffer being filled
+static int ssd1306_tx_len = 0;
+
+void SSD1306_tx_init() {
+    hal_i2c_stream_init(SSD1306_I2C_ADDR);
 }
 
-void SSD1306_send_cmd_list(uint8_t *buf, int num) {
-    for (int i=0;i<num;i++)
-        SSD1306_send_cmd(buf[i]);
+static bool SSD1306_tx_wait(bool until_idle) {
+    // wait for the transfer in flight, and optionally for the bus to go idle
+    if (hal_i2c_stream_wait(until_idle, SSD1306_TX_TIMEOUT_US))
+        return true;
+
+    // timeout or NAK: the rest of the stream was dropped, so whatever reached the
+    // display is unknown now
+    ssd1306_stats.tx_errors++;
+    ssd1306_shadow_valid = false;
+    return false;
 }
 
-void SSD1306_send_buf(uint8_t buf[], int buflen) {
-    // in horizontal addressing mode, the column address pointer auto-increments
-    // and then wraps around to the next page, so we can send the entire frame
-    // buffer in one gooooooo!
+void SSD1306_tx_kick() {
+    // start sending the queued stream in the background
+    if (ssd1306_tx_len == 0)
+        return;
 
-    // copy our frame buffer into a new buffer because we need to add the control byte
-    // to the beginning
+    uint64_t start = hal_time_us_64();
+    SSD1306_tx_wait(false);
+    ssd1306_stats.last_wait_us = (uint32_t)(hal_time_us_64() - start);
 
-    uint8_t *temp_buf = (uint8_t *)malloc(buflen + 1);
+    hal_i2c_stream_start(ssd1306_tx[ssd1306_tx_fill], ssd1306_tx_len);
+    ssd1306_tx_fill ^= 1;
+    ssd1306_tx_len = 0;
+}
+
+bool SSD1306_tx_flush() {
+    // send what is queued and wait until it is on the wire
+    SSD1306_tx_kick();
+    return SSD1306_tx_wait(true);
+}
+
+static void SSD1306_tx_transaction(uint8_t control, const uint8_t *bytes, int num) {
+    // queue one I2C write: control byte, payload, STOP on the last byte
+    if (ssd1306_tx_len + num + 1 > SSD1306_TX_WORDS)
+        SSD1306_tx_kick();
 
-    temp_buf[0] = 0x40;
-    memcpy(temp_buf+1, buf, buflen);
+    uint16_t *out = &ssd1306_tx[ssd1306_tx_fill][ssd1306_tx_len];
+    *out++ = control;
+    for (int i = 0; i < num; i++)
+        *out++ = bytes[i];
+    out[-1] |= HAL_I2C_STOP;
 
-    i2c_write_blocking(i2c1, SSD1306_I2C_ADDR, temp_buf, buflen + 1, false);
+    ssd1306_tx_len += num + 1;
+    ssd1306_stats.total_bytes += num + 1;
+}
+
+void SSD1306_send_cmd_list(uint8_t *buf, int num) {
+    // Co = 0, D/C = 0 => every byte that follows in this transaction is a command,
+    // so the whole list goes out in a single write
+    SSD1306_tx_transaction(0x00, buf, num);
+    SSD1306_tx_flush();
+}
 
-    free(temp_buf);
+void SSD1306_send_cmd(uint8_t cmd) {
+    SSD1306_send_cmd_list(&cmd, 1);
+}
+
+void SSD1306_send_buf(uint8_t buf[], int buflen) {
+    // in horizontal addressing mode, the column address pointer auto-increments
+    // and then wraps around to the next page, so we can send the entire frame
+    // buffer in one gooooooo!
+    // Co = 0, D/C = 1 => the driver expects data
+    SSD1306_tx_transaction(0x40, buf, buflen);
+    SSD1306_tx_flush();
 }
 
 void SSD1306_init() {
@@ -98,6 +172,8 @@ void SSD1306_init() {
     // to demonstrate what the initialization sequence looks like
     // Some configuration values are recommended by the board manufacturer
 
+    SSD1306_tx_init();
+
     uint8_t cmds[] = {
         SSD1306_SET_DISP,               // set display off
         /* memory mapping */
@@ -155,9 +231,61 @@ void SSD1306_scroll(bool on) {
     };
 
     SSD1306_send_cmd_list(cmds, count_of(cmds));
+
+    // scrolling moves the RAM contents, so the shadow no longer matches
+    ssd1306_shadow_valid = false;
+}
+
+void SSD1306_set_contrast(uint8_t contrast) {
+    // segment drive current: roughly proportional to the panel's current draw
+    uint8_t cmds[] = {SSD1306_SET_CONTRAST, contrast};
+    SSD1306_send_cmd_list(cmds, count_of(cmds));
+}
+
+void SSD1306_set_display_on(bool on) {
+    // display off is the controller's sleep mode (charge pump off, ~10 uA); the RAM
+    // is kept, so the shadow used by render_diff() stays valid
+    SSD1306_send_cmd(SSD1306_SET_DISP | (on ? 0x01 : 0x00));
+}
+
+void render_diff(uint8_t *buf);
+
+void render_window(uint8_t *buf, uint8_t start_col, uint8_t end_col, uint8_t start_page, uint8_t end_page) {
+    // send a rectangle of a full-frame buffer; in horizontal addressing mode the
+    // column pointer wraps back to start_col when it passes end_col
+    uint8_t cmds[] = {
+        SSD1306_SET_COL_ADDR,
+        start_col,
+        end_col,
+        SSD1306_SET_PAGE_ADDR,
+        start_page,
+        end_page
+    };
+    SSD1306_tx_transaction(0x00, cmds, count_of(cmds));
+
+    int width = end_col - start_col + 1;
+    if (width == SSD1306_WIDTH) {
+        SSD1306_tx_transaction(0x40, &buf[start_page * SSD1306_WIDTH], width * (end_page - start_page + 1));
+        return;
+    }
+
+    // the address pointer survives between I2C transactions, so each page row can
+    // be queued straight from the frame buffer
+    for (int page = start_page; page <= end_page; page++)
+        SSD1306_tx_transaction(0x40, &buf[page * SSD1306_WIDTH + start_col], width);
 }
 
 void render(uint8_t *buf, struct render_area *area) {
+    if (area->start_col == 0 && area->end_col == SSD1306_WIDTH - 1 &&
+        area->start_page == 0 && area->end_page == SSD1306_NUM_PAGES - 1) {
+        // full frame: only the parts that changed since the last frame go out
+        render_diff(buf);
+        return;
+    }
+
+    // a partial area is written from its own buffer, so the shadow is stale
+    ssd1306_shadow_valid = false;
+
     // update a portion of the display with a render area
     uint8_t cmds[] = {
         SSD1306_SET_COL_ADDR,
@@ -168,11 +296,81 @@ void render(uint8_t *buf, struct render_area *area) {
         area->end_page
     };
 
-    SSD1306_send_cmd_list(cmds, count_of(cmds));
-    SSD1306_send_buf(buf, area->buflen);
+    // the stream keeps its own copy of the data, so the caller's buffer is free as
+    // soon as this returns
+    SSD1306_tx_transaction(0x00, cmds, count_of(cmds));
+    SSD1306_tx_transaction(0x40, buf, area->buflen);
+    SSD1306_tx_kick();
 }
 
-static void SetPixel(uint8_t *buf, int x,int y, bool on) {
+void render_diff(uint8_t *buf) {
+    // find, for each page, the first and last column that differ from what the display
+    // already shows, and send only those windows
+    int first[SSD1306_NUM_PAGES], last[SSD1306_NUM_PAGES];
+
+    for (int page = 0; page < (int)SSD1306_NUM_PAGES; page++) {
+        const uint8_t *row = &buf[page * SSD1306_WIDTH];
+        const uint8_t *old = &ssd1306_shadow[page * SSD1306_WIDTH];
+
+        if (!ssd1306_shadow_valid) {
+            first[page] = 0;
+            last[page] = SSD1306_WIDTH - 1;
+            continue;
+        }
+
+        int lo = 0, hi = SSD1306_WIDTH - 1;
+        while (lo < SSD1306_WIDTH && row[lo] == old[lo])
+            lo++;
+        if (lo == SSD1306_WIDTH) {
+            first[page] = -1; // page unchanged
+            continue;
+        }
+        while (row[hi] == old[hi])
+            hi--;
+        first[page] = lo;
+        last[page] = hi;
+    }
+
+    uint64_t bytes_before = ssd1306_stats.total_bytes;
+    uint32_t windows = 0;
+
+    int page = 0;
+    while (page < (int)SSD1306_NUM_PAGES) {
+        if (first[page] < 0) {
+            page++;
+            continue;
+        }
+
+        // grow the window downwards while merging is cheaper than a new window
+        int lo = first[page], hi = last[page], end = page;
+        while (end + 1 < (int)SSD1306_NUM_PAGES && first[end + 1] >= 0) {
+            int nlo = lo < first[end + 1] ? lo : first[end + 1];
+            int nhi = hi > last[end + 1] ? hi : last[end + 1];
+            int merged = (nhi - nlo + 1) * (end - page + 2);
+            int separate = (hi - lo + 1) * (end - page + 1) + (last[end + 1] - first[end + 1] + 1);
+            if (merged - separate > SSD1306_WINDOW_OVERHEAD)
+                break;
+            lo = nlo;
+            hi = nhi;
+            end++;
+        }
+
+        render_window(buf, lo, hi, page, end);
+        windows++;
+        page = end + 1;
+    }
+
+    SSD1306_tx_kick();
+
+    memcpy(ssd1306_shadow, buf, SSD1306_BUF_LEN);
+    ssd1306_shadow_valid = true;
+
+    ssd1306_stats.frames++;
+    ssd1306_stats.last_windows = windows;
+    ssd1306_stats.last_bytes = (uint32_t)(ssd1306_stats.total_bytes - bytes_before);
+}
+
+static inline void SetPixel(uint8_t *buf, int x,int y, bool on) {
     assert(x >= 0 && x < SSD1306_WIDTH && y >=0 && y < SSD1306_HEIGHT);
 
     // The calculation to determine the correct bit to set depends on which address
@@ -197,8 +395,85 @@ static void SetPixel(uint8_t *buf, int x,int y, bool on) {
 
     buf[byte_idx] = byte;
 }
-// Basic Bresenhams.
-static void DrawLine(uint8_t *buf, int x0, int y0, int x1, int y1, bool on) {
+// Raster primitives. SetPixel() above is the per-pixel reference; everything below
+// writes whole frame buffer bytes with page masks and clips to the screen, so
+// coordinates may be partly or fully off screen.
+
+static inline void WriteMasked(uint8_t *p, uint8_t mask, bool on) {
+    if (on)
+        *p |= mask;
+    else
+        *p &= ~mask;
+}
+
+// Filled rectangle: one masked byte per column for each page it touches
+static void FillRect(uint8_t *buf, int x, int y, int w, int h, bool on) {
+    int x0 = x < 0 ? 0 : x;
+    int x1 = x + w > SSD1306_WIDTH ? SSD1306_WIDTH : x + w;
+    int y0 = y < 0 ? 0 : y;
+    int y1 = y + h > SSD1306_HEIGHT ? SSD1306_HEIGHT : y + h;
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    for (int page = y0 / 8; page <= (y1 - 1) / 8; page++) {
+        int top = y0 > page * 8 ? y0 - page * 8 : 0;
+        int bottom = y1 < page * 8 + 8 ? y1 - page * 8 : 8;
+        uint8_t mask = (uint8_t)((0xFF << top) & (0xFF >> (8 - bottom)));
+        uint8_t *row = &buf[page * SSD1306_WIDTH];
+        for (int i = x0; i < x1; i++)
+            WriteMasked(&row[i], mask, on);
+    }
+}
+
+// Spans, endpoints inclusive and in any order
+static void DrawHLine(uint8_t *buf, int x0, int x1, int y, bool on) {
+    if (x0 > x1) {
+        int t = x0; x0 = x1; x1 = t;
+    }
+    FillRect(buf, x0, y, x1 - x0 + 1, 1, on);
+}
+
+static void DrawVLine(uint8_t *buf, int x, int y0, int y1, bool on) {
+    if (y0 > y1) {
+        int t = y0; y0 = y1; y1 = t;
+    }
+    FillRect(buf, x, y0, 1, y1 - y0 + 1, on);
+}
+
+static inline void DrawRect(uint8_t *buf, int x, int y, int w, int h, bool on) {
+    if (w <= 0 || h <= 0)
+        return;
+    DrawHLine(buf, x, x + w - 1, y, on);
+    DrawHLine(buf, x, x + w - 1, y + h - 1, on);
+    DrawVLine(buf, x, y, y + h - 1, on);
+    DrawVLine(buf, x + w - 1, y, y + h - 1, on);
+}
+
+// Vertical bar meter in a w x h box: the bottom `level` rows are lit and the rest
+// cleared, so a meter can be redrawn in place without clearing the frame first
+static void DrawBarMeter(uint8_t *buf, int x, int y, int w, int h, int level) {
+    if (level < 0)
+        level = 0;
+    if (level > h)
+        level = h;
+    FillRect(buf, x, y, w, h - level, false);
+    FillRect(buf, x, y + h - level, w, level, true);
+}
+
+// Basic Bresenhams, clipped. Pixels that land in the same frame buffer byte
+// (steep runs inside one page) are gathered into a mask and written once.
+static inline void DrawLine(uint8_t *buf, int x0, int y0, int x1, int y1, bool on) {
+    if (y0 == y1) {
+        DrawHLine(buf, x0, x1, y0, on);
+        return;
+    }
+    if (x0 == x1) {
+        DrawVLine(buf, x0, y0, y1, on);
+        return;
+    }
+    if ((x0 < 0 && x1 < 0) || (x0 >= SSD1306_WIDTH && x1 >= SSD1306_WIDTH) ||
+        (y0 < 0 && y1 < 0) || (y0 >= SSD1306_HEIGHT && y1 >= SSD1306_HEIGHT))
+        return;
 
     int dx =  abs(x1-x0);
     int sx = x0<x1 ? 1 : -1;
@@ -207,8 +482,20 @@ static void DrawLine(uint8_t *buf, int x0, int y0, int x1, int y1, bool on) {
     int err = dx+dy;
     int e2;
 
+    int byte_idx = -1;
+    uint8_t mask = 0;
+
     while (true) {
-        SetPixel(buf, x0, y0, on);
+        if ((unsigned)x0 < SSD1306_WIDTH && (unsigned)y0 < SSD1306_HEIGHT) {
+            int idx = (y0 >> 3) * SSD1306_WIDTH + x0;
+            if (idx != byte_idx) {
+                if (byte_idx >= 0)
+                    WriteMasked(&buf[byte_idx], mask, on);
+                byte_idx = idx;
+                mask = 0;
+            }
+            mask |= 1 << (y0 & 7);
+        }
         if (x0 == x1 && y0 == y1)
             break;
         e2 = 2*err;
@@ -222,53 +509,91 @@ static void DrawLine(uint8_t *buf, int x0, int y0, int x1, int y1, bool on) {
             y0 += sy;
         }
     }
+    if (byte_idx >= 0)
+        WriteMasked(&buf[byte_idx], mask, on);
 }
 
-static inline int GetFontIndex(uint8_t ch) {
-    if (ch >= 'A' && ch <='Z') {
-        return  ch - 'A' + 1;
-    }
-    else if (ch >= '0' && ch <='9') {
-        return  ch - '0' + 27;
-    }
-    else if (ch == ':') {
-        return 37; // Índice para '!'
-    }
-    else if (ch == '.') {
-        return 38; // Índice para '.'
+// Text is drawn column by column: each glyph column is one vertical byte, placed at
+// any y by splitting it across two pages with a shift and a mask. Only the glyph's
+// own 8 rows are overwritten, so text can sit over a graph without clearing it.
+static inline void BlitColumn(uint8_t *buf, int x, int y, uint8_t col) {
+    if (x < 0 || x >= SSD1306_WIDTH || y <= -FONT_HEIGHT || y >= SSD1306_HEIGHT)
+        return;
+
+    int page = (y + FONT_HEIGHT) / 8 - 1; // floor(y / 8), also for y < 0
+    int shift = y - page * 8;
+
+    if (page >= 0) {
+        uint8_t *p = &buf[page * SSD1306_WIDTH + x];
+        *p = (*p & (uint8_t)~(0xFF << shift)) | (uint8_t)(col << shift);
     }
-    else {
-        return 0; // Se o caractere não estiver definido, retorna "nada" (espaço)
+    if (shift && page + 1 < (int)SSD1306_NUM_PAGES) {
+        uint8_t *p = &buf[(page + 1) * SSD1306_WIDTH + x];
+        *p = (*p & (uint8_t)(0xFF << shift)) | (uint8_t)(col >> (8 - shift));
     }
 }
 
-static void WriteChar(uint8_t *buf, int16_t x, int16_t y, uint8_t ch) {
-    if (x > SSD1306_WIDTH - 8 || y > SSD1306_HEIGHT - 8)
+static void BlitGlyph(uint8_t *buf, int x, int y, const uint8_t *cols, int width) {
+    if (y <= -FONT_HEIGHT || y >= SSD1306_HEIGHT)
         return;
 
-    // For the moment, only write on Y row boundaries (every 8 vertical pixels)
-    y = y/8;
-
-    ch = toupper(ch);
-    int idx = GetFontIndex(ch);
-    int fb_idx = y * 128 + x;
+    // clip horizontally once, then work on whole columns; the pointers start at the
+    // first visible column, so none of them points outside buf
+    int first = x < 0 ? -x : 0;
+    int last = x + width > SSD1306_WIDTH ? SSD1306_WIDTH - x : width;
+    if (last <= first)
+        return;
+    int count = last - first;
+    cols += first;
+    x += first;
+
+    int page = (y + FONT_HEIGHT) / 8 - 1;
+    int shift = y - page * 8;
+    uint8_t *top = page >= 0 ? &buf[page * SSD1306_WIDTH + x] : NULL;
+    uint8_t *bottom = shift && page + 1 < (int)SSD1306_NUM_PAGES ? &buf[(page + 1) * SSD1306_WIDTH + x] : NULL;
+
+    if (!shift) {
+        // on a page boundary a glyph is a plain copy
+        for (int i = 0; i < count; i++)
+            top[i] = cols[i];
+        return;
+    }
 
-    for (int i=0;i<8;i++) {
-        buf[fb_idx++] = font[idx * 8 + i];
+    uint8_t top_keep = (uint8_t)~(0xFF << shift), bottom_keep = (uint8_t)(0xFF << shift);
+    for (int i = 0; i < count; i++) {
+        if (top)
+            top[i] = (top[i] & top_keep) | (uint8_t)(cols[i] << shift);
+        if (bottom)
+            bottom[i] = (bottom[i] & bottom_keep) | (uint8_t)(cols[i] >> (8 - shift));
     }
 }
 
-static void WriteString(uint8_t *buf, int16_t x, int16_t y, char *str) {
-    // Cull out any string off the screen
-    if (x > SSD1306_WIDTH - 8 || y > SSD1306_HEIGHT - 8)
+static void WriteChar(uint8_t *buf, int16_t x, int16_t y, uint8_t ch) {
+    BlitGlyph(buf, x, y, font_mono[font_index[ch]], FONT_MONO_WIDTH);
+}
+
+// Monospaced, 8 pixels per character
+static void WriteString(uint8_t *buf, int16_t x, int16_t y, const char *str) {
+    if (y <= -FONT_HEIGHT || y >= SSD1306_HEIGHT)
         return;
 
-    while (*str) {
+    while (*str && x < SSD1306_WIDTH) {
         WriteChar(buf, x, y, *str++);
-        x+=8;
+        x += FONT_MONO_WIDTH;
     }
 }
 
-
-
-#endif
\ No newline at end of file
+// Proportional: each glyph is as wide as its drawing plus one blank column, so about
+// 25 characters fit on a line instead of 16. Returns the x after the last glyph.
+static inline int WriteStringProp(uint8_t *buf, int16_t x, int16_t y, const char *str) {
+    if (y <= -FONT_HEIGHT || y >= SSD1306_HEIGHT)
+        return x;
+
+    while (*str && x < SSD1306_WIDTH) {
+        const FontPropGlyph *g = &font_prop[font_index[(uint8_t)*str++]];
+        BlitGlyph(buf, x, y, &font_prop_data[g->offset], g->width);
+        BlitColumn(buf, x + g->width, y, 0x00);
+        x += g->width + 1;
+    }
+    return x;
+}
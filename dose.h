@@ -0,0 +1,142 @@
+// Dose de ruído contínua (NIOSH e OSHA).
+//
+// A cada bloco de medição a dose recebe dt / T(L), onde T(L) é o tempo permitido no
+// nível L pelo critério:  T(L) = 8 h / 2^((L - critério) / troca).
+// Assim 100% de dose equivale a 8 h no nível de critério, e um bloco a 96 dB conta
+// como 96 dB, não como a faixa de 94 dB.
+//
+// 1 / T(L) vem de uma tabela calculada uma única vez em dose_init() (passo de
+// 0.1 dB, com interpolação linear), sem powf por bloco. Depois de dose_init() a
+// tabela só é lida, então os dois núcleos podem consultá-la.
+//
+// As doses de todos os critérios são acumuladas em paralelo; a interface escolhe
+// qual mostrar e usar no alarme. Abaixo do limiar (80 dB) nada é acumulado.
+//
+// O tempo é contado em amostras (uint64_t) e a dose em double: perto de 8 h um
+// float já não representa bem o incremento de um bloco de 100 ms (o tempo ficaria
+// 0.3% curto e a dose derivaria na mesma ordem). Depende de mic_capture.h
+// (MIC_SAMPLE_RATE_HZ), incluído antes.
+
+#include <stdint.h>
+#include <math.h>
+
+typedef enum
+{
+  DOSE_NIOSH = 0, // 85 dB, troca de 3 dB
+  DOSE_OSHA,      // 90 dB, troca de 5 dB
+  DOSE_CRITERIA_COUNT
+} DoseCriterionId;
+
+typedef struct
+{
+  const char *name;
+  float criterion_db; // Nível que dá 100% em DOSE_REFERENCE_S
+  float exchange_db;  // Aumento que divide o tempo permitido por dois
+  float threshold_db; // Níveis abaixo deste não contam
+} DoseCriterion;
+
+static const DoseCriterion dose_criteria[DOSE_CRITERIA_COUNT] = {
+    {"NIOSH", 85.0f, 3.0f, 80.0f},
+    {"OSHA", 90.0f, 5.0f, 80.0f},
+};
+
+#define DOSE_REFERENCE_S (8.0f * 3600.0f) // Jornada de referência
+#define DOSE_TABLE_MIN_DB 80.0f
+#define DOSE_TABLE_MAX_DB 140.0f
+#define DOSE_TABLE_STEPS_PER_DB 10
+#define DOSE_TABLE_LEN ((int)((DOSE_TABLE_MAX_DB - DOSE_TABLE_MIN_DB) * DOSE_TABLE_STEPS_PER_DB) + 1)
+
+#define DOSE_PROJECTION_TAU_S 30.0f // Constante de tempo da taxa usada na projeção
+
+// Fração de dose por segundo em cada nível da tabela
+static float dose_rate_table[DOSE_CRITERIA_COUNT][DOSE_TABLE_LEN];
+
+typedef struct
+{
+  double dose[DOSE_CRITERIA_COUNT];    // 1.0 = 100%
+  float rate_avg[DOSE_CRITERIA_COUNT]; // Taxa média recente (fração por segundo)
+  uint64_t duration_samples;           // Tempo medido desde o último zeramento
+} DoseState;
+
+void dose_init()
+{
+  for (int c = 0; c < DOSE_CRITERIA_COUNT; c++)
+  {
+    const DoseCriterion *crit = &dose_criteria[c];
+    for (int i = 0; i < DOSE_TABLE_LEN; i++)
+    {
+      float db = DOSE_TABLE_MIN_DB + (float)i / DOSE_TABLE_STEPS_PER_DB;
+      dose_rate_table[c][i] = db < crit->threshold_db
+                                  ? 0.0f
+                                  : powf(2.0f, (db - crit->criterion_db) / crit->exchange_db) / DOSE_REFERENCE_S;
+    }
+  }
+}
+
+// Fração de dose por segundo no nível db
+static inline float dose_rate(int criterion, float db)
+{
+  float pos = (db - DOSE_TABLE_MIN_DB) * DOSE_TABLE_STEPS_PER_DB;
+  if (pos < 0.0f)
+    return 0.0f;
+  if (pos >= DOSE_TABLE_LEN - 1)
+    return dose_rate_table[criterion][DOSE_TABLE_LEN - 1];
+  int i = (int)pos;
+  float frac = pos - i;
+  const float *t = dose_rate_table[criterion];
+  return t[i] + (t[i + 1] - t[i]) * frac;
+}
+
+// Tempo permitido no nível db (INFINITY abaixo do limiar)
+static inline float dose_allowed_seconds(int criterion, float db)
+{
+  float rate = dose_rate(criterion, db);
+  return rate > 0.0f ? 1.0f / rate : INFINITY;
+}
+
+void dose_reset(DoseState *s)
+{
+  for (int c = 0; c < DOSE_CRITERIA_COUNT; c++)
+  {
+    s->dose[c] = 0.0;
+    s->rate_avg[c] = 0.0f;
+  }
+  s->duration_samples = 0;
+}
+
+// Acumula samples amostras (a MIC_SAMPLE_RATE_HZ) no nível db
+void dose_update(DoseState *s, float db, uint32_t samples)
+{
+  float dt = (float)samples / MIC_SAMPLE_RATE_HZ;
+  float k = dt < DOSE_PROJECTION_TAU_S ? dt / DOSE_PROJECTION_TAU_S : 1.0f;
+  for (int c = 0; c < DOSE_CRITERIA_COUNT; c++)
+  {
+    float rate = dose_rate(c, db);
+    s->dose[c] += (double)rate * dt;
+    s->rate_avg[c] += (rate - s->rate_avg[c]) * k;
+  }
+  s->duration_samples += samples;
+}
+
+// Dose em centésimos de % (1.0 = 10000), saturada em 16 bits, para telemetria e histórico
+static inline uint16_t dose_to_x10000(double dose)
+{
+  double v = dose * 10000.0;
+  return v >= 65535.0 ? 65535 : v <= 0.0 ? 0 : (uint16_t)v;
+}
+
+// Tempo medido desde o último zeramento (s), para exibição
+static inline uint32_t dose_duration_s(const DoseState *s)
+{
+  return (uint32_t)(s->duration_samples / MIC_SAMPLE_RATE_HZ);
+}
+
+// Tempo projetado até 100% de dose, mantido o nível médio recente (0 se já atingiu)
+static inline float dose_projected_seconds(const DoseState *s, int criterion)
+{
+  float remaining = 1.0f - (float)s->dose[criterion];
+  if (remaining <= 0.0f)
+    return 0.0f;
+  float rate = s->rate_avg[criterion];
+  return rate > 0.0f ? remaining / rate : INFINITY;
+}
@@ -0,0 +1,145 @@
+// Histórico do nível em várias resoluções, com memória fixa.
+//
+// Cada nível (ENV_TIERS) é um anel de ENV_COLUMNS colunas com mínimo, máximo e Leq
+// em centi-dB. As colunas são dizimadas em cascata conforme os blocos chegam: o
+// nível 0 fecha uma coluna a cada segundo de amostras (no bloco que cruza o limite,
+// então a duração média é exata mesmo com blocos de tamanho variável), e cada coluna
+// fechada entra no acumulador do nível seguinte, que fecha depois de env_ratio[]
+// colunas (1 min, 5 min). O Leq soma energia e amostras, como em stats.h
+// (level_db.h incluído antes), então a média do nível 2 é exata e não uma média de dB.
+//
+// Com 128 colunas: 2 min a 1 s, 2 h 8 min a 1 min e 10 h 40 min (um turno) a 5 min.
+// Cada bloco custa no máximo ENV_TIERS acumulações e cada leitura é um anel fixo,
+// então desenhar qualquer zoom leva o mesmo tempo.
+
+#include <stdint.h>
+#include <string.h>
+
+#define ENV_COLUMNS 128
+#define ENV_TIERS 3
+
+// Quantas colunas do nível anterior formam uma coluna (o nível 0 fecha por tempo)
+static const uint8_t env_ratio[ENV_TIERS] = {1, 60, 5};
+// Duração de uma coluna de cada nível, em segundos
+static const uint16_t env_column_s[ENV_TIERS] = {1, 60, 300};
+
+typedef struct
+{
+  int16_t min_cdb;
+  int16_t max_cdb;
+  int16_t leq_cdb;
+} EnvColumn;
+
+typedef struct
+{
+  EnvColumn cols[ENV_COLUMNS];
+  uint32_t head; // Colunas fechadas até agora; a próxima vai em head % ENV_COLUMNS
+} EnvTier;
+
+typedef struct
+{
+  uint64_t energy; // Mesma escala de level_cdb_from_energy
+  uint64_t samples;
+  int32_t min_cdb;
+  int32_t max_cdb;
+  uint32_t count; // Entradas acumuladas na coluna em andamento
+} EnvAccum;
+
+typedef struct
+{
+  EnvTier tier[ENV_TIERS];
+  EnvAccum acc[ENV_TIERS];
+  int32_t offset_cdb;        // Offset de level_cdb_from_energy
+  uint32_t column_samples;   // Amostras por coluna do nível 0 (1 s)
+  uint64_t total_samples;    // Amostras recebidas desde env_init()
+  uint64_t next_close;       // total_samples em que o nível 0 fecha a próxima coluna
+} EnvelopeStore;
+
+static void env_accum_reset(EnvAccum *a)
+{
+  memset(a, 0, sizeof(*a));
+  a->min_cdb = INT32_MAX;
+  a->max_cdb = INT32_MIN;
+}
+
+void env_init(EnvelopeStore *e, int32_t offset_cdb, uint32_t sample_rate)
+{
+  memset(e, 0, sizeof(*e));
+  for (int t = 0; t < ENV_TIERS; t++)
+    env_accum_reset(&e->acc[t]);
+  e->offset_cdb = offset_cdb;
+  e->column_samples = sample_rate;
+  e->next_close = sample_rate;
+}
+
+static void env_accum_merge(EnvAccum *a, uint64_t energy, uint64_t samples, int32_t min_cdb, int32_t max_cdb)
+{
+  // Perto do estouro as duas somas são divididas por 2; o Leq (a razão) se mantém
+  if (a->energy > UINT64_MAX - energy)
+  {
+    a->energy >>= 1;
+    a->samples >>= 1;
+    energy >>= 1;
+    samples >>= 1;
+  }
+  a->energy += energy;
+  a->samples += samples;
+  if (min_cdb < a->min_cdb)
+    a->min_cdb = min_cdb;
+  if (max_cdb > a->max_cdb)
+    a->max_cdb = max_cdb;
+  a->count++;
+}
+
+static int16_t env_clamp(int32_t cdb)
+{
+  return (int16_t)(cdb < INT16_MIN ? INT16_MIN : cdb > INT16_MAX ? INT16_MAX : cdb);
+}
+
+// Acrescenta um bloco de medição. Retorna uma máscara com os níveis que fecharam
+// uma coluna (bit t = nível t), para o chamador publicar só o que mudou.
+uint32_t env_add(EnvelopeStore *e, int32_t level_cdb, uint64_t energy, uint32_t samples)
+{
+  uint64_t in_energy = energy, in_samples = samples;
+  int32_t in_min = level_cdb, in_max = level_cdb;
+  uint32_t closed = 0;
+
+  e->total_samples += samples;
+  for (int t = 0; t < ENV_TIERS; t++)
+  {
+    EnvAccum *a = &e->acc[t];
+    env_accum_merge(a, in_energy, in_samples, in_min, in_max);
+    if (t == 0 ? e->total_samples < e->next_close : a->count < env_ratio[t])
+      break;
+    if (t == 0)
+      e->next_close += e->column_samples;
+
+    EnvTier *tier = &e->tier[t];
+    EnvColumn *c = &tier->cols[tier->head % ENV_COLUMNS];
+    c->min_cdb = env_clamp(a->min_cdb);
+    c->max_cdb = env_clamp(a->max_cdb);
+    c->leq_cdb = env_clamp(level_cdb_from_energy(a->energy, a->samples, e->offset_cdb));
+    tier->head++;
+    closed |= 1u << t;
+
+    // A coluna fechada é a entrada do próximo nível
+    in_energy = a->energy;
+    in_samples = a->samples;
+    in_min = a->min_cdb;
+    in_max = a->max_cdb;
+    env_accum_reset(a);
+  }
+  return closed;
+}
+
+// Colunas com dados (até ENV_COLUMNS)
+static inline uint32_t env_filled(const EnvTier *tier)
+{
+  return tier->head < ENV_COLUMNS ? tier->head : ENV_COLUMNS;
+}
+
+// Coluna de idade age (0 = a mais recente); age < env_filled()
+static inline const EnvColumn *env_column(const EnvTier *tier, uint32_t age)
+{
+  return &tier->cols[(tier->head - 1 - age) % ENV_COLUMNS];
+}
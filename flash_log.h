@@ -0,0 +1,363 @@
+// Registro histórico em flash: anel estruturado em log, com nivelamento de desgaste.
+//
+// A região (a flash livre depois da imagem do programa) é dividida em setores de
+// 4 KB usados em sequência circular, então todos são apagados o mesmo número de
+// vezes. Cada setor tem 128 posições de 32 bytes: a posição 0 guarda o cabeçalho
+// (número de sequência do setor) e as outras 127 guardam registros de um minuto.
+//
+// Os registros são acumulados na RAM e gravados uma página (256 bytes) por vez.
+// Gravar uma página paralisa a execução a partir da flash nos dois núcleos por menos
+// de 1 ms, coberto pelo anel de amostras na RAM (170 ms). Apagar um setor pode levar
+// mais que isso no pior caso, então flash_log_prepare() apaga com antecedência os
+// próximos setores do anel, na inicialização, antes de a captura começar; ao chegar
+// a um setor já apagado o anel só grava o cabeçalho.
+//
+// Recuperação de gravação interrompida (queda de energia): na inicialização o setor
+// com o maior número de sequência válido é o atual; a gravação continua na primeira
+// página totalmente apagada dele. Registros com CRC inválido são ignorados na leitura
+// e uma página parcialmente gravada nunca é reaproveitada. Um setor cujo apagamento
+// foi interrompido não tem cabeçalho válido e é apagado de novo quando o anel voltar.
+//
+// Este arquivo não depende do SDK: o acesso à flash é feito pelas funções de
+// FlashLogIo, para que o mesmo código rode no simulador de imagem de flash do host
+// (tools/flash_log_sim.cpp).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define FLASH_LOG_SECTOR_SIZE 4096
+#define FLASH_LOG_PAGE_SIZE 256
+#define FLASH_LOG_SLOT_SIZE 32
+#define FLASH_LOG_SLOTS_PER_PAGE (FLASH_LOG_PAGE_SIZE / FLASH_LOG_SLOT_SIZE)
+#define FLASH_LOG_SLOTS_PER_SECTOR (FLASH_LOG_SECTOR_SIZE / FLASH_LOG_SLOT_SIZE)
+#define FLASH_LOG_MAGIC 0x474F4C53u // "SLOG"
+
+// Registro de um minuto (32 bytes)
+typedef struct
+{
+  uint32_t seq;           // Número do registro, crescente em toda a região
+  uint32_t minute;        // Minutos desde a inicialização
+  uint16_t boot;          // Contagem de inicializações
+  int16_t leq_cdb;        // Leq do minuto (centi-dB)
+  int16_t lmax_cdb;       // Maior nível de bloco do minuto
+  uint16_t dose_niosh;    // Dose acumulada em centésimos de % (saturada)
+  uint16_t dose_osha;
+  uint16_t alarms_safe;   // alarmCountSafe
+  uint16_t alarms_volume; // alarmCountMaxVolume
+  uint8_t alarm_state;    // AlarmState no fim do minuto
+  uint8_t weighting;      // Ponderação em uso
+  uint16_t shift_minutes; // Tempo de exposição somado na dose (minutos)
+  uint8_t reset_reason;   // Causa desta inicialização (HalResetReason)
+  uint8_t shift;          // FlashLogShift: como a dose desta inicialização começou
+  uint32_t crc;           // CRC-32 dos 28 bytes anteriores
+} FlashLogRecord;
+
+// Origem da dose e dos contadores de alarme de uma inicialização. Registros antigos,
+// gravados com esses bytes em zero, ficam como jornada nova.
+typedef enum
+{
+  FLASH_LOG_SHIFT_NEW = 0, // Partiram de zero
+  FLASH_LOG_SHIFT_RESUMED, // Retomados do último registro da inicialização anterior
+  FLASH_LOG_SHIFT_PENDING, // Aguardando a escolha do usuário
+} FlashLogShift;
+
+typedef struct
+{
+  uint32_t magic;
+  uint32_t sector_seq; // Sequência do setor; o maior válido é o atual
+  uint8_t reserved[20];
+  uint32_t crc;
+} FlashLogHeader;
+
+static_assert(sizeof(FlashLogRecord) == FLASH_LOG_SLOT_SIZE, "registro deve ocupar uma posição");
+static_assert(sizeof(FlashLogHeader) == FLASH_LOG_SLOT_SIZE, "cabeçalho deve ocupar uma posição");
+
+typedef struct
+{
+  const uint8_t *base; // Conteúdo da região para leitura direta (XIP no RP2040)
+  uint32_t sectors;    // Setores na região
+  bool (*erase)(uint32_t offset);                          // Apaga o setor em offset
+  bool (*program)(uint32_t offset, const uint8_t *page);   // Grava uma página em offset
+} FlashLogIo;
+
+typedef struct
+{
+  FlashLogIo io;
+  uint32_t sector;     // Setor atual
+  uint32_t sector_seq; // Sequência do setor atual (0 = nenhum setor ainda)
+  uint32_t next_slot;  // Primeira posição livre do setor atual (início de página)
+  uint32_t record_seq; // Sequência do próximo registro
+  uint8_t page[FLASH_LOG_PAGE_SIZE];
+  uint32_t page_used;  // Posições preenchidas em page
+  uint32_t torn;       // Páginas/registros inválidos encontrados na inicialização
+  uint32_t write_errors;
+} FlashLog;
+
+static uint32_t flash_log_crc32(const uint8_t *data, uint32_t len)
+{
+  uint32_t crc = 0xFFFFFFFFu;
+  for (uint32_t i = 0; i < len; i++)
+  {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++)
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+  }
+  return ~crc;
+}
+
+static inline const uint8_t *flash_log_slot(const FlashLog *log, uint32_t sector, uint32_t slot)
+{
+  return log->io.base + sector * FLASH_LOG_SECTOR_SIZE + slot * FLASH_LOG_SLOT_SIZE;
+}
+
+static bool flash_log_erased(const uint8_t *p, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++)
+    if (p[i] != 0xFF)
+      return false;
+  return true;
+}
+
+// Retorna a sequência do setor, ou 0 se o cabeçalho for inválido
+static uint32_t flash_log_sector_seq(const FlashLog *log, uint32_t sector)
+{
+  FlashLogHeader h;
+  memcpy(&h, flash_log_slot(log, sector, 0), sizeof(h));
+  if (h.magic != FLASH_LOG_MAGIC || h.crc != flash_log_crc32((const uint8_t *)&h, offsetof(FlashLogHeader, crc)))
+    return 0;
+  return h.sector_seq;
+}
+
+static bool flash_log_record_valid(const FlashLogRecord *r)
+{
+  return r->crc == flash_log_crc32((const uint8_t *)r, offsetof(FlashLogRecord, crc));
+}
+
+// Registro válido da posição, se houver
+static bool flash_log_read_slot(const FlashLog *log, uint32_t sector, uint32_t slot, FlashLogRecord *out)
+{
+  memcpy(out, flash_log_slot(log, sector, slot), sizeof(*out));
+  return flash_log_record_valid(out);
+}
+
+// Último registro válido já gravado na flash
+bool flash_log_last(const FlashLog *log, FlashLogRecord *out)
+{
+  if (log->sector_seq == 0)
+    return false;
+
+  // Do setor atual para trás no anel, até achar um registro válido
+  uint32_t sector = log->sector;
+  uint32_t seq = log->sector_seq;
+  for (uint32_t n = 0; n < log->io.sectors; n++)
+  {
+    if (flash_log_sector_seq(log, sector) != seq)
+    {
+      // O setor atual pode ainda não ter chegado à flash (página pendente)
+      if (n > 0)
+        return false;
+    }
+    else
+      for (int32_t slot = FLASH_LOG_SLOTS_PER_SECTOR - 1; slot >= 1; slot--)
+        if (flash_log_read_slot(log, sector, slot, out))
+          return true;
+    sector = (sector + log->io.sectors - 1) % log->io.sectors;
+    seq--;
+  }
+  return false;
+}
+
+// Procura o setor atual e a próxima página livre
+void flash_log_init(FlashLog *log, const FlashLogIo *io)
+{
+  memset(log, 0, sizeof(*log));
+  log->io = *io;
+
+  for (uint32_t s = 0; s < log->io.sectors; s++)
+  {
+    uint32_t seq = flash_log_sector_seq(log, s);
+    if (seq > log->sector_seq)
+    {
+      log->sector_seq = seq;
+      log->sector = s;
+    }
+  }
+  if (log->sector_seq == 0)
+  {
+    // Região nova: o primeiro setor é apagado na primeira gravação
+    log->sector = log->io.sectors - 1;
+    log->next_slot = FLASH_LOG_SLOTS_PER_SECTOR;
+    return;
+  }
+
+  // Primeira página totalmente apagada; páginas parcialmente gravadas ficam para trás
+  log->next_slot = FLASH_LOG_SLOTS_PER_SECTOR;
+  for (uint32_t slot = 0; slot < FLASH_LOG_SLOTS_PER_SECTOR; slot += FLASH_LOG_SLOTS_PER_PAGE)
+  {
+    if (flash_log_erased(flash_log_slot(log, log->sector, slot), FLASH_LOG_PAGE_SIZE))
+    {
+      log->next_slot = slot;
+      break;
+    }
+  }
+
+  for (uint32_t slot = 1; slot < log->next_slot; slot++)
+  {
+    FlashLogRecord r;
+    if (!flash_log_read_slot(log, log->sector, slot, &r) &&
+        !flash_log_erased(flash_log_slot(log, log->sector, slot), FLASH_LOG_SLOT_SIZE))
+      log->torn++;
+  }
+
+  // Continua a numeração a partir do último registro válido
+  FlashLogRecord last;
+  if (flash_log_last(log, &last))
+    log->record_seq = last.seq + 1;
+}
+
+// Grava a página pendente, completando com 0xFF
+bool flash_log_flush(FlashLog *log)
+{
+  if (log->page_used == 0)
+    return true;
+
+  memset(log->page + log->page_used * FLASH_LOG_SLOT_SIZE, 0xFF, FLASH_LOG_PAGE_SIZE - log->page_used * FLASH_LOG_SLOT_SIZE);
+  uint32_t offset = log->sector * FLASH_LOG_SECTOR_SIZE + log->next_slot * FLASH_LOG_SLOT_SIZE;
+  bool ok = log->io.program(offset, log->page);
+  if (!ok)
+    log->write_errors++;
+
+  // Mesmo com erro a página é dada como usada: nunca se grava duas vezes sobre ela
+  log->next_slot += FLASH_LOG_SLOTS_PER_PAGE;
+  log->page_used = 0;
+  return ok;
+}
+
+static inline bool flash_log_sector_erased(const FlashLog *log, uint32_t sector)
+{
+  return flash_log_erased(flash_log_slot(log, sector, 0), FLASH_LOG_SECTOR_SIZE);
+}
+
+// Apaga os próximos count setores do anel que ainda não estão apagados (o atual
+// nunca). Retorna quantos foram apagados.
+uint32_t flash_log_prepare(FlashLog *log, uint32_t count)
+{
+  if (log->io.sectors == 0)
+    return 0;
+  if (count > log->io.sectors - 1)
+    count = log->io.sectors - 1;
+
+  uint32_t erased = 0;
+  for (uint32_t i = 1; i <= count; i++)
+  {
+    uint32_t sector = (log->sector + i) % log->io.sectors;
+    if (flash_log_sector_erased(log, sector))
+      continue;
+    if (log->io.erase(sector * FLASH_LOG_SECTOR_SIZE))
+      erased++;
+    else
+      log->write_errors++;
+  }
+  return erased;
+}
+
+// Passa para o próximo setor do anel: apaga, se preciso, e põe o cabeçalho na
+// página pendente
+static bool flash_log_open_sector(FlashLog *log)
+{
+  uint32_t sector = (log->sector + 1) % log->io.sectors;
+  bool ok = flash_log_sector_erased(log, sector) || log->io.erase(sector * FLASH_LOG_SECTOR_SIZE);
+  if (!ok)
+    log->write_errors++;
+
+  log->sector = sector;
+  log->sector_seq++;
+  log->next_slot = 0;
+
+  FlashLogHeader h;
+  memset(&h, 0, sizeof(h));
+  h.magic = FLASH_LOG_MAGIC;
+  h.sector_seq = log->sector_seq;
+  h.crc = flash_log_crc32((const uint8_t *)&h, offsetof(FlashLogHeader, crc));
+  memcpy(log->page, &h, sizeof(h));
+  log->page_used = 1;
+  return ok;
+}
+
+// Acrescenta um registro (seq e crc são preenchidos aqui). A gravação na flash só
+// acontece quando uma página fica completa.
+bool flash_log_append(FlashLog *log, FlashLogRecord *rec)
+{
+  if (log->io.sectors == 0)
+    return false;
+
+  bool ok = true;
+  if (log->page_used == 0 && log->next_slot >= FLASH_LOG_SLOTS_PER_SECTOR)
+    ok = flash_log_open_sector(log);
+
+  rec->seq = log->record_seq++;
+  rec->crc = flash_log_crc32((const uint8_t *)rec, offsetof(FlashLogRecord, crc));
+  memcpy(log->page + log->page_used * FLASH_LOG_SLOT_SIZE, rec, sizeof(*rec));
+  log->page_used++;
+
+  if (log->page_used == FLASH_LOG_SLOTS_PER_PAGE)
+    ok = flash_log_flush(log) && ok;
+  return ok;
+}
+
+// Leitura do histórico aos poucos, do registro mais antigo para o mais novo
+typedef struct
+{
+  uint32_t sector; // Setor em leitura
+  uint32_t left;   // Setores que faltam, contando o atual
+  uint32_t slot;   // Próxima posição do setor
+} FlashLogCursor;
+
+// Posiciona o cursor no setor mais antigo ainda válido: o que tem sequência contínua
+// até o atual. Registros que ainda estão na página da RAM não são lidos.
+void flash_log_cursor_init(const FlashLog *log, FlashLogCursor *cur)
+{
+  cur->sector = log->sector;
+  cur->left = 0;
+  cur->slot = 1;
+  if (log->sector_seq == 0)
+    return;
+
+  uint32_t seq = log->sector_seq;
+  cur->left = 1;
+  while (cur->left < log->io.sectors && seq > 1)
+  {
+    uint32_t prev = (cur->sector + log->io.sectors - 1) % log->io.sectors;
+    if (flash_log_sector_seq(log, prev) != seq - 1)
+      break;
+    cur->sector = prev;
+    seq--;
+    cur->left++;
+  }
+}
+
+// Próximo registro válido; false quando os setores acabaram
+bool flash_log_next(const FlashLog *log, FlashLogCursor *cur, FlashLogRecord *out)
+{
+  while (cur->left > 0)
+  {
+    while (cur->slot < FLASH_LOG_SLOTS_PER_SECTOR)
+      if (flash_log_read_slot(log, cur->sector, cur->slot++, out))
+        return true;
+    cur->sector = (cur->sector + 1) % log->io.sectors;
+    cur->slot = 1;
+    cur->left--;
+  }
+  return false;
+}
+
+// Chama cb para cada registro válido na flash, do mais antigo para o mais novo
+void flash_log_for_each(const FlashLog *log, void (*cb)(const FlashLogRecord *rec, void *ctx), void *ctx)
+{
+  FlashLogCursor cur;
+  FlashLogRecord r;
+  flash_log_cursor_init(log, &cur);
+  while (flash_log_next(log, &cur, &r))
+    cb(&r, ctx);
+}
@@ -0,0 +1,147 @@
+// Decodificador de gestos do joystick, sem dependência de hardware.
+//
+// A posição (leituras de 12 bits dos dois eixos) vira deflexão em % do curso e passa
+// por um passa-baixas de um polo (2^-GESTURE_FILTER_SHIFT por leitura, 80 ms a
+// 50 Hz). Uma direção é escolhida quando o eixo dominante passa de GESTURE_ENTER_PCT
+// e só é solta quando o mesmo eixo volta abaixo de GESTURE_EXIT_PCT; entre os dois
+// limiares nada muda, então o ruído perto da borda não alterna a direção.
+//
+// Cada deflexão gera no máximo um evento de cada tipo:
+// - FLICK: soltou antes de GESTURE_HOLD_MS (emitido ao soltar);
+// - HOLD: continua defletido em GESTURE_HOLD_MS (emitido sem esperar soltar);
+// - LONG_HOLD: continua defletido em GESTURE_LONG_HOLD_MS.
+// Eixos como no BitDogLab: vertical alto = cima, horizontal alto = direita.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define GESTURE_ENTER_PCT 40
+#define GESTURE_EXIT_PCT 25
+#define GESTURE_FILTER_SHIFT 2
+#define GESTURE_HOLD_MS 400
+#define GESTURE_LONG_HOLD_MS 1500
+
+typedef enum
+{
+  GESTURE_NONE = 0,
+  GESTURE_FLICK,
+  GESTURE_HOLD,
+  GESTURE_LONG_HOLD
+} GestureKind;
+
+typedef enum
+{
+  GESTURE_DIR_NONE = 0,
+  GESTURE_DIR_UP,
+  GESTURE_DIR_DOWN,
+  GESTURE_DIR_LEFT,
+  GESTURE_DIR_RIGHT
+} GestureDir;
+
+typedef struct
+{
+  GestureKind kind;
+  GestureDir dir;
+} GestureEvent;
+
+typedef struct
+{
+  int32_t horz, vert; // Deflexão filtrada, % do curso em Q8
+  bool primed;
+  GestureDir dir;     // Direção defletida (NONE = centro)
+  uint64_t since_us;  // Início da deflexão
+  uint8_t stage;      // Eventos já emitidos: 0 nenhum, 1 HOLD, 2 LONG_HOLD
+} GestureDecoder;
+
+void gesture_init(GestureDecoder *g)
+{
+  g->horz = g->vert = 0;
+  g->primed = false;
+  g->dir = GESTURE_DIR_NONE;
+  g->since_us = 0;
+  g->stage = 0;
+}
+
+// Deflexão de uma leitura de 12 bits, em % do curso e Q8
+static inline int32_t gesture_deflection_q8(uint16_t raw)
+{
+  return ((int32_t)raw - 2048) * 100 * 256 / 2048;
+}
+
+// Deflexão filtrada (Q8) no sentido de uma direção
+static inline int32_t gesture_along(const GestureDecoder *g, GestureDir dir)
+{
+  switch (dir)
+  {
+  case GESTURE_DIR_UP:
+    return g->vert;
+  case GESTURE_DIR_DOWN:
+    return -g->vert;
+  case GESTURE_DIR_LEFT:
+    return -g->horz;
+  case GESTURE_DIR_RIGHT:
+    return g->horz;
+  default:
+    return 0;
+  }
+}
+
+// Joystick fora do centro (conta como entrada do usuário)
+static inline bool gesture_active(const GestureDecoder *g)
+{
+  return g->dir != GESTURE_DIR_NONE;
+}
+
+// Uma leitura dos dois eixos. Retorna true e preenche ev quando um gesto termina ou
+// atinge um tempo de espera.
+bool gesture_update(GestureDecoder *g, uint16_t raw_horz, uint16_t raw_vert, uint64_t now_us, GestureEvent *ev)
+{
+  int32_t h = gesture_deflection_q8(raw_horz), v = gesture_deflection_q8(raw_vert);
+  if (!g->primed)
+  {
+    g->horz = h;
+    g->vert = v;
+    g->primed = true;
+  }
+  g->horz += (h - g->horz) >> GESTURE_FILTER_SHIFT;
+  g->vert += (v - g->vert) >> GESTURE_FILTER_SHIFT;
+
+  if (g->dir == GESTURE_DIR_NONE)
+  {
+    int32_t ah = g->horz < 0 ? -g->horz : g->horz;
+    int32_t av = g->vert < 0 ? -g->vert : g->vert;
+    if ((ah > av ? ah : av) <= GESTURE_ENTER_PCT * 256)
+      return false;
+    if (av >= ah)
+      g->dir = g->vert > 0 ? GESTURE_DIR_UP : GESTURE_DIR_DOWN;
+    else
+      g->dir = g->horz > 0 ? GESTURE_DIR_RIGHT : GESTURE_DIR_LEFT;
+    g->since_us = now_us;
+    g->stage = 0;
+    return false;
+  }
+
+  ev->dir = g->dir;
+  if (gesture_along(g, g->dir) < GESTURE_EXIT_PCT * 256)
+  {
+    bool flick = g->stage == 0;
+    g->dir = GESTURE_DIR_NONE;
+    ev->kind = GESTURE_FLICK;
+    return flick;
+  }
+
+  uint64_t held_us = now_us - g->since_us;
+  if (g->stage == 0 && held_us >= GESTURE_HOLD_MS * 1000ull)
+  {
+    g->stage = 1;
+    ev->kind = GESTURE_HOLD;
+    return true;
+  }
+  if (g->stage == 1 && held_us >= GESTURE_LONG_HOLD_MS * 1000ull)
+  {
+    g->stage = 2;
+    ev->kind = GESTURE_LONG_HOLD;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,121 @@
+// Camada de abstração do hardware (HAL).
+//
+// O firmware (U7T_JVPdO.cpp e os módulos .h) só fala com o hardware pelas funções
+// hal_* declaradas aqui. Há duas implementações:
+// - hal_pico.h: RP2040 com o Pico SDK (o firmware de verdade);
+// - sim/hal_sim.h: Linux, compilada com SIMIS_HOST pelo alvo de simulação (sim/),
+//   com relógio virtual, ADC alimentado por arquivo ou gerador e o SSD1306 emulado.
+// A medição, a dose, o alarme e a interface são o mesmo código nos dois casos.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef SIMIS_HOST
+typedef unsigned int uint; // Como em pico/types.h
+#define _u(x) x##u
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#else
+#include "pico/stdlib.h"
+#endif
+
+// Tempo. No simulador o relógio é virtual e só avança nas esperas.
+uint64_t hal_time_us_64();
+uint32_t hal_time_us_32();
+void hal_sleep_ms(uint32_t ms);
+void hal_sleep_us(uint64_t us);
+
+// Relógio do sistema (power.h). O clk_peri acompanha o clk_sys, então a
+// implementação reaplica a taxa do I2C; quem chama espera o barramento ficar livre.
+// O tempo (hal_time_*) e o ADC não dependem do clk_sys.
+bool hal_set_sys_clock_khz(uint32_t khz);
+uint32_t hal_sys_clock_khz();
+
+// Alarmes de tempo: o callback roda em interrupção e devolve o atraso até a próxima
+// chamada em µs (negativo = contado a partir do agendamento anterior, 0 = para)
+typedef int32_t hal_alarm_id_t;
+typedef int64_t (*hal_alarm_cb_t)(hal_alarm_id_t id, void *user_data);
+hal_alarm_id_t hal_alarm_in_ms(uint32_t ms, hal_alarm_cb_t cb, void *user_data);
+void hal_alarm_cancel(hal_alarm_id_t id);
+
+// GPIO e interrupção nas duas bordas (botões); events traz as bordas vistas
+#define HAL_GPIO_EDGE_FALL 0x4u
+#define HAL_GPIO_EDGE_RISE 0x8u
+typedef void (*hal_gpio_irq_cb_t)(uint pin, uint32_t events);
+void hal_gpio_output(uint pin); // Saída, começa em 0
+void hal_gpio_input_pullup(uint pin);
+void hal_gpio_irq_edges(uint pin, hal_gpio_irq_cb_t cb);
+void hal_gpio_put(uint pin, bool value);
+bool hal_gpio_get(uint pin);
+
+// Buzzer por PWM
+void hal_buzzer_init(uint pin);
+void hal_buzzer_tone(uint pin, uint frequency); // 0 = silêncio
+
+// ADC. hal_adc_read() faz uma conversão avulsa, só antes de a captura começar.
+void hal_adc_gpio_init(uint pin);
+void hal_adc_init();
+uint16_t hal_adc_read(uint8_t channel);
+
+// Captura contínua em um anel de 2^ring_bits bytes (alinhado ao próprio tamanho). O
+// ADC alterna (round-robin) entre channel e os canais de aux_mask, cada um a rate_hz:
+// cada quadro do anel começa pela conversão de channel, seguida dos canais de
+// aux_mask em ordem crescente a partir dele (com volta). hal_mic_captured() é o
+// número absoluto de conversões já escritas (0 antes do início), legível de qualquer
+// núcleo. Um estouro da FIFO perde uma conversão e desalinha os quadros;
+// hal_mic_restart() para o ADC e o DMA, esvazia a FIFO e recomeça pelo canal
+// principal. A próxima conversão é a de número múltiplo de align (pulando as que
+// faltam) e vai para a posição dela no anel; o número é devolvido. Só no núcleo da
+// captura.
+void hal_mic_start(uint8_t channel, uint8_t aux_mask, uint16_t *ring, uint32_t ring_bits, uint32_t rate_hz);
+uint64_t hal_mic_captured();
+bool hal_mic_fifo_overflow(); // Houve estouro desde a última chamada
+uint64_t hal_mic_restart(uint32_t align);
+
+// Fluxo de escrita I2C em segundo plano: cada palavra é um byte; HAL_I2C_STOP na
+// palavra fecha a transação. hal_i2c_stream_wait() retorna false se a transferência
+// foi abortada (tempo esgotado ou NAK) e o resto do fluxo se perdeu.
+#define HAL_I2C_STOP 0x200u
+void hal_i2c_init(uint sda_pin, uint scl_pin, uint32_t baud);
+void hal_i2c_stream_init(uint8_t addr);
+void hal_i2c_stream_start(const uint16_t *words, uint32_t count);
+bool hal_i2c_stream_wait(bool until_idle, uint32_t timeout_us);
+
+// Serial (USB CDC no RP2040)
+void hal_serial_init();
+void hal_serial_putc(uint8_t c);
+int hal_serial_getc(); // -1 se não houver byte
+bool hal_serial_connected(); // Há um terminal do outro lado
+
+// Núcleo 1 e barreira de memória entre os núcleos (ipc.h)
+void hal_core1_launch(void (*entry)());
+void hal_core1_lockout_victim_init(); // Permite pausar este núcleo durante a gravação da flash
+static inline void hal_dmb();
+
+// Região livre da flash para o histórico (flash_log.h); offsets relativos à região
+void hal_flash_region(const uint8_t **base, uint32_t *sectors);
+bool hal_flash_erase(uint32_t offset);
+bool hal_flash_program(uint32_t offset, const uint8_t *page);
+
+// Causa da inicialização atual. No RP2040 a queda de tensão (brown-out) e a falta de
+// energia dão o mesmo reset do chip, então as duas são HAL_RESET_POWER.
+typedef enum
+{
+  HAL_RESET_POWER = 0, // Energia ligada ou queda de tensão
+  HAL_RESET_PIN,       // Pino RUN (botão de reset)
+  HAL_RESET_WATCHDOG,  // Watchdog, inclusive o reinício por software (picotool)
+} HalResetReason;
+HalResetReason hal_reset_reason();
+
+// Contador crescente para medir trechos curtos: ciclos do processador no RP2040
+// (24 bits, SysTick), nanossegundos no host. Diferenças com & HAL_CYCLES_MASK.
+// A implementação define também HAL_CYCLES_UNIT e HAL_TARGET_NAME para os relatórios.
+void hal_cycles_start();
+uint32_t hal_cycles();
+uint32_t hal_cycles_hz(); // Contagens por segundo
+
+#ifdef SIMIS_HOST
+#include "sim/hal_sim.h"
+#else
+#include "hal_pico.h"
+#endif
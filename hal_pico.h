@@ -0,0 +1,480 @@
+// Implementação da HAL (hal.h) para o RP2040 com o Pico SDK.
+
+#include "pico/multicore.h"
+#include "pico/flash.h"
+
+#include "hardware/gpio.h"
+#include "hardware/adc.h"
+#include "hardware/i2c.h"
+#include "hardware/clocks.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/flash.h"
+#include "hardware/watchdog.h"
+#include "hardware/structs/vreg_and_chip_reset.h"
+#include "hardware/structs/systick.h"
+
+#define HAL_CYCLES_MASK 0x00FFFFFFu
+#define HAL_CYCLES_UNIT "cycles"
+#define HAL_CYCLES_UNIT_SHORT "cy"
+#define HAL_TARGET_NAME "rp2040"
+
+static_assert(HAL_I2C_STOP == I2C_IC_DATA_CMD_STOP_BITS, "a palavra do fluxo vai direto para IC_DATA_CMD");
+
+static uint32_t hal_i2c_baud = 0; // Taxa pedida em hal_i2c_init(), reaplicada ao trocar o relógio
+
+// ---- Tempo ----
+
+uint64_t hal_time_us_64()
+{
+  return time_us_64();
+}
+
+uint32_t hal_time_us_32()
+{
+  return time_us_32();
+}
+
+void hal_sleep_ms(uint32_t ms)
+{
+  sleep_ms(ms);
+}
+
+void hal_sleep_us(uint64_t us)
+{
+  sleep_us(us);
+}
+
+bool hal_set_sys_clock_khz(uint32_t khz)
+{
+  if (!set_sys_clock_khz(khz, false))
+    return false;
+  i2c_set_baudrate(i2c1, hal_i2c_baud); // Divisores recalculados para o novo clk_peri
+  return true;
+}
+
+uint32_t hal_sys_clock_khz()
+{
+  return clock_get_hz(clk_sys) / 1000;
+}
+
+hal_alarm_id_t hal_alarm_in_ms(uint32_t ms, hal_alarm_cb_t cb, void *user_data)
+{
+  return add_alarm_in_ms(ms, cb, user_data, true);
+}
+
+void hal_alarm_cancel(hal_alarm_id_t id)
+{
+  cancel_alarm(id);
+}
+
+// ---- GPIO ----
+
+void hal_gpio_output(uint pin)
+{
+  gpio_init(pin);
+  gpio_set_dir(pin, GPIO_OUT);
+  gpio_put(pin, 0);
+}
+
+void hal_gpio_input_pullup(uint pin)
+{
+  gpio_set_dir(pin, GPIO_IN);
+  gpio_pull_up(pin);
+}
+
+void hal_gpio_irq_edges(uint pin, hal_gpio_irq_cb_t cb)
+{
+  gpio_set_irq_enabled_with_callback(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, cb);
+}
+
+void hal_gpio_put(uint pin, bool value)
+{
+  gpio_put(pin, value);
+}
+
+bool hal_gpio_get(uint pin)
+{
+  return gpio_get(pin);
+}
+
+// ---- Buzzer ----
+
+void hal_buzzer_init(uint pin)
+{
+  gpio_set_function(pin, GPIO_FUNC_PWM);
+  uint slice_num = pwm_gpio_to_slice_num(pin);
+  pwm_config config = pwm_get_default_config();
+  pwm_config_set_clkdiv(&config, 4.0f); // Ajusta divisor de clock
+  pwm_init(slice_num, &config, true);
+  pwm_set_gpio_level(pin, 0); // Desliga o PWM inicialmente
+}
+
+void hal_buzzer_tone(uint pin, uint frequency)
+{
+  if (frequency == 0)
+  {
+    pwm_set_gpio_level(pin, 0);
+    return;
+  }
+
+  uint slice_num = pwm_gpio_to_slice_num(pin);
+  uint32_t clock_freq = clock_get_hz(clk_sys);
+  uint32_t top = clock_freq / frequency - 1;
+
+  // Volume fixo: 1% do período
+  uint32_t level = top / 100;
+
+  pwm_set_wrap(slice_num, top);
+  pwm_set_gpio_level(pin, level);
+}
+
+// ---- ADC e captura do microfone ----
+//
+// ADC em modo livre (adc_run + FIFO) alimentando, via DMA, o anel. O DMA é programado
+// para uma "época" longa (2^31 transferências, ~6 h com três canais a 32 kHz); o
+// contador de transferências restantes do canal fornece o número absoluto de
+// conversões sem uma interrupção por bloco. A época é múltipla do tamanho do anel,
+// então o índice absoluto continua alinhado ao buffer.
+//
+// A base da época muda na interrupção do DMA, no núcleo 1, e o núcleo 0 também lê o
+// contador (joystick): base e contador são publicados com uma sequência, como o
+// seqlock de ipc.h, e hal_mic_captured() relê até pegar os dois da mesma época.
+#define HAL_MIC_DMA_EPOCH (1u << 31)
+
+static int hal_mic_dma_chan = -1;
+static uint8_t hal_mic_channel = 0;
+static uint16_t *hal_mic_ring = NULL;
+static uint32_t hal_mic_ring_samples = 0;
+static volatile bool hal_mic_running = false; // O núcleo 0 lê o contador (joystick)
+static volatile uint64_t hal_mic_epoch_base = 0;
+static volatile uint32_t hal_mic_seq = 0;     // Ímpar enquanto base e contador mudam
+
+static void hal_mic_dma_irq_handler()
+{
+  if (dma_channel_get_irq1_status(hal_mic_dma_chan))
+  {
+    dma_channel_acknowledge_irq1(hal_mic_dma_chan);
+    // Fim de uma época: reinicia a contagem; o endereço de escrita segue no anel
+    hal_mic_seq = hal_mic_seq + 1;
+    __dmb();
+    hal_mic_epoch_base += HAL_MIC_DMA_EPOCH;
+    dma_channel_set_trans_count(hal_mic_dma_chan, HAL_MIC_DMA_EPOCH, true);
+    __dmb();
+    hal_mic_seq = hal_mic_seq + 1;
+  }
+}
+
+void hal_adc_gpio_init(uint pin)
+{
+  adc_gpio_init(pin);
+}
+
+void hal_adc_init()
+{
+  adc_init();
+  adc_set_clkdiv(96.0f); // Configura o divisor de clock do ADC
+}
+
+uint16_t hal_adc_read(uint8_t channel)
+{
+  adc_select_input(channel);
+  return adc_read();
+}
+
+void hal_mic_start(uint8_t channel, uint8_t aux_mask, uint16_t *ring, uint32_t ring_bits, uint32_t rate_hz)
+{
+  uint8_t mask = aux_mask | (1u << channel);
+  uint32_t conversions = __builtin_popcount(mask);
+
+  // A primeira conversão é a do AINSEL; depois dela o ADC passa ao próximo canal da
+  // máscara, em ordem crescente e com volta
+  hal_mic_channel = channel;
+  hal_mic_ring = ring;
+  hal_mic_ring_samples = (1u << ring_bits) / sizeof(uint16_t);
+  adc_select_input(channel);
+  adc_set_round_robin(conversions > 1 ? mask : 0);
+  adc_fifo_setup(true,  // Escreve cada conversão na FIFO
+                 true,  // Habilita o DREQ para o DMA
+                 1,     // DREQ a cada amostra
+                 false, // Sem bit de erro
+                 false  // Mantém 12 bits (sem deslocar para 8)
+  );
+  adc_set_clkdiv((float)clock_get_hz(clk_adc) / (rate_hz * conversions) - 1.0f);
+
+  hal_mic_dma_chan = dma_claim_unused_channel(true);
+  dma_channel_config cfg = dma_channel_get_default_config(hal_mic_dma_chan);
+  channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+  channel_config_set_read_increment(&cfg, false);
+  channel_config_set_write_increment(&cfg, true);
+  channel_config_set_ring(&cfg, true, ring_bits); // Escrita dá a volta no anel
+  channel_config_set_dreq(&cfg, DREQ_ADC);
+
+  dma_channel_set_irq1_enabled(hal_mic_dma_chan, true);
+  irq_set_exclusive_handler(DMA_IRQ_1, hal_mic_dma_irq_handler);
+  irq_set_enabled(DMA_IRQ_1, true);
+
+  dma_channel_configure(hal_mic_dma_chan, &cfg, ring, &adc_hw->fifo, HAL_MIC_DMA_EPOCH, true);
+
+  adc_fifo_drain();
+  adc_run(true);
+  hal_mic_running = true;
+}
+
+uint64_t hal_mic_captured()
+{
+  if (!hal_mic_running)
+    return 0;
+  for (;;)
+  {
+    uint32_t seq = hal_mic_seq;
+    __dmb();
+    uint64_t base = hal_mic_epoch_base;
+    uint32_t remaining = dma_hw->ch[hal_mic_dma_chan].transfer_count;
+    __dmb();
+    if (!(seq & 1) && seq == hal_mic_seq)
+      return base + (HAL_MIC_DMA_EPOCH - remaining);
+  }
+}
+
+uint64_t hal_mic_restart(uint32_t align)
+{
+  uint32_t irq_state = save_and_disable_interrupts();
+  adc_run(false);
+  // Abortar com a interrupção do canal ligada pode gerá-la sem fim de época (RP2040-E13)
+  dma_channel_set_irq1_enabled(hal_mic_dma_chan, false);
+  dma_channel_abort(hal_mic_dma_chan);
+  dma_channel_acknowledge_irq1(hal_mic_dma_chan);
+  while (!(adc_hw->cs & ADC_CS_READY_BITS)) // Conversão em andamento
+    tight_loop_contents();
+  adc_fifo_drain();
+  hw_set_bits(&adc_hw->fcs, ADC_FCS_OVER_BITS | ADC_FCS_UNDER_BITS);
+
+  // Próxima conversão: a primeira de um quadro, na posição dela no anel
+  uint64_t start = hal_mic_captured();
+  start = (start + align - 1) / align * align;
+  hal_mic_seq = hal_mic_seq + 1;
+  __dmb();
+  hal_mic_epoch_base = start;
+  dma_channel_set_write_addr(hal_mic_dma_chan, hal_mic_ring + start % hal_mic_ring_samples, false);
+  dma_channel_set_trans_count(hal_mic_dma_chan, HAL_MIC_DMA_EPOCH, true);
+  __dmb();
+  hal_mic_seq = hal_mic_seq + 1;
+  dma_channel_set_irq1_enabled(hal_mic_dma_chan, true);
+
+  adc_select_input(hal_mic_channel);
+  adc_run(true);
+  restore_interrupts(irq_state);
+  return start;
+}
+
+bool hal_mic_fifo_overflow()
+{
+  if (!(adc_hw->fcs & ADC_FCS_OVER_BITS))
+    return false;
+  hw_set_bits(&adc_hw->fcs, ADC_FCS_OVER_BITS); // Bit limpo com escrita de 1
+  return true;
+}
+
+// ---- I2C ----
+//
+// O fluxo de palavras vai por um canal de DMA para a FIFO de transmissão: o byte
+// baixo é o dado e o bit 9 (STOP) fecha a transação, então uma transferência leva
+// várias transações seguidas.
+
+static int hal_i2c_dma_chan = -1;
+
+void hal_i2c_init(uint sda_pin, uint scl_pin, uint32_t baud)
+{
+  // I2C é dreno aberto: pull-ups mantêm o sinal alto sem transmissão
+  hal_i2c_baud = baud;
+  i2c_init(i2c1, baud);
+  gpio_set_function(sda_pin, GPIO_FUNC_I2C);
+  gpio_set_function(scl_pin, GPIO_FUNC_I2C);
+  gpio_pull_up(sda_pin);
+  gpio_pull_up(scl_pin);
+}
+
+void hal_i2c_stream_init(uint8_t addr)
+{
+  // O endereço do alvo é fixo: programado uma vez, não a cada transferência
+  i2c_hw_t *hw = i2c_get_hw(i2c1);
+  hw->enable = 0;
+  hw->tar = addr;
+  hw->enable = 1;
+
+  hal_i2c_dma_chan = dma_claim_unused_channel(true);
+  dma_channel_config cfg = dma_channel_get_default_config(hal_i2c_dma_chan);
+  // Escritas de 16 bits são replicadas no barramento de 32; a metade alta de
+  // IC_DATA_CMD é reservada, então só a baixa importa
+  channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+  channel_config_set_read_increment(&cfg, true);
+  channel_config_set_write_increment(&cfg, false);
+  channel_config_set_dreq(&cfg, i2c_get_dreq(i2c1, true));
+  dma_channel_configure(hal_i2c_dma_chan, &cfg, &hw->data_cmd, NULL, 0, false);
+}
+
+static void hal_i2c_abort()
+{
+  i2c_hw_t *hw = i2c_get_hw(i2c1);
+
+  dma_channel_abort(hal_i2c_dma_chan);
+  // ABORT esvazia a FIFO de transmissão e gera um STOP; limitado caso o barramento trave
+  hw->enable |= I2C_IC_ENABLE_ABORT_BITS;
+  uint64_t start = time_us_64();
+  while ((hw->enable & I2C_IC_ENABLE_ABORT_BITS) && time_us_64() - start < 1000)
+    tight_loop_contents();
+  (void)hw->clr_tx_abrt;
+}
+
+void hal_i2c_stream_start(const uint16_t *words, uint32_t count)
+{
+  dma_channel_transfer_from_buffer_now(hal_i2c_dma_chan, words, count);
+}
+
+bool hal_i2c_stream_wait(bool until_idle, uint32_t timeout_us)
+{
+  i2c_hw_t *hw = i2c_get_hw(i2c1);
+  uint64_t start = time_us_64();
+
+  while (dma_channel_is_busy(hal_i2c_dma_chan) ||
+         (until_idle && (!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_ACTIVITY_BITS))))
+  {
+    if (time_us_64() - start > timeout_us)
+    {
+      hal_i2c_abort();
+      return false;
+    }
+    tight_loop_contents();
+  }
+
+  if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)
+  {
+    // NAK ou perda de arbitragem: o controlador descartou o resto do fluxo
+    (void)hw->clr_tx_abrt;
+    return false;
+  }
+  return true;
+}
+
+// ---- Serial ----
+
+void hal_serial_init()
+{
+  stdio_init_all();
+}
+
+void hal_serial_putc(uint8_t c)
+{
+  putchar_raw(c);
+}
+
+int hal_serial_getc()
+{
+  int c = getchar_timeout_us(0);
+  return c == PICO_ERROR_TIMEOUT ? -1 : c;
+}
+
+bool hal_serial_connected()
+{
+  return stdio_usb_connected();
+}
+
+// ---- Núcleos ----
+
+void hal_core1_launch(void (*entry)())
+{
+  multicore_launch_core1(entry);
+}
+
+void hal_core1_lockout_victim_init()
+{
+  multicore_lockout_victim_init();
+}
+
+static inline void hal_dmb()
+{
+  __dmb();
+}
+
+// ---- Flash ----
+//
+// A região vai do fim da imagem do programa até o fim da flash. Apagar e gravar usam
+// flash_safe_execute(), que pausa o outro núcleo durante a operação; a captura
+// continua pelo DMA.
+#define HAL_FLASH_LOCKOUT_TIMEOUT_MS 100
+
+extern char __flash_binary_end;
+
+static uint32_t hal_flash_offset; // Início da região na flash
+
+typedef struct
+{
+  uint32_t offset;
+  const uint8_t *page;
+} HalFlashOp;
+
+static void hal_flash_erase_op(void *param)
+{
+  flash_range_erase(((HalFlashOp *)param)->offset, FLASH_SECTOR_SIZE);
+}
+
+static void hal_flash_program_op(void *param)
+{
+  HalFlashOp *op = (HalFlashOp *)param;
+  flash_range_program(op->offset, op->page, FLASH_PAGE_SIZE);
+}
+
+void hal_flash_region(const uint8_t **base, uint32_t *sectors)
+{
+  uint32_t binary_end = (uint32_t)((uintptr_t)&__flash_binary_end - XIP_BASE);
+  hal_flash_offset = (binary_end + FLASH_SECTOR_SIZE - 1) & ~(FLASH_SECTOR_SIZE - 1);
+  *base = (const uint8_t *)(uintptr_t)(XIP_BASE + hal_flash_offset);
+  *sectors = hal_flash_offset < PICO_FLASH_SIZE_BYTES ? (PICO_FLASH_SIZE_BYTES - hal_flash_offset) / FLASH_SECTOR_SIZE : 0;
+}
+
+bool hal_flash_erase(uint32_t offset)
+{
+  HalFlashOp op = {hal_flash_offset + offset, NULL};
+  return flash_safe_execute(hal_flash_erase_op, &op, HAL_FLASH_LOCKOUT_TIMEOUT_MS) == PICO_OK;
+}
+
+bool hal_flash_program(uint32_t offset, const uint8_t *page)
+{
+  HalFlashOp op = {hal_flash_offset + offset, page};
+  return flash_safe_execute(hal_flash_program_op, &op, HAL_FLASH_LOCKOUT_TIMEOUT_MS) == PICO_OK;
+}
+
+// ---- Causa da inicialização ----
+
+// O watchdog reinicia sem resetar o chip, então CHIP_RESET ainda traz a causa do
+// último reset do chip: HAD_RUN (pino RUN) ou HAD_POR (energia ou brown-out)
+HalResetReason hal_reset_reason()
+{
+  if (watchdog_caused_reboot())
+    return HAL_RESET_WATCHDOG;
+  if (vreg_and_chip_reset_hw->chip_reset & VREG_AND_CHIP_RESET_CHIP_RESET_HAD_RUN_BITS)
+    return HAL_RESET_PIN;
+  return HAL_RESET_POWER;
+}
+
+// ---- Contador de ciclos ----
+
+void hal_cycles_start()
+{
+  systick_hw->rvr = 0x00FFFFFF;
+  systick_hw->cvr = 0;
+  systick_hw->csr = 0x5; // Habilitado, clock do processador
+}
+
+uint32_t hal_cycles()
+{
+  return HAL_CYCLES_MASK - systick_hw->cvr; // O SysTick conta para baixo
+}
+
+uint32_t hal_cycles_hz()
+{
+  return clock_get_hz(clk_sys);
+}
@@ -0,0 +1,242 @@
+// Fila de eventos dos botões, alimentada pela interrupção de GPIO.
+//
+// A interrupção (input_isr) faz só o debounce de cada pino e grava a borda aceita,
+// com pino, sentido e instante, em um anel sem travas: um produtor (a interrupção) e
+// um consumidor (a tarefa de entrada), com os índices publicados como na fila SPSC
+// de ipc.h (incluído antes). Cada pino tem o próprio estado: a borda que chega
+// menos de INPUT_DEBOUNCE_US depois da última aceita no mesmo pino é trepidação do
+// contato e é descartada, sem afetar os outros botões. Se a última borda descartada
+// for a que mudou o nível (um toque mais curto que a janela, ou uma trepidação que
+// termina depois dela), nenhuma borda vem depois; por isso o consumidor relê o nível
+// do pino (hal_gpio_get, com pull-up: nível baixo = apertado) quando a janela acaba e
+// a fila está vazia, e cria a borda que faltou.
+//
+// O consumidor (input_next) transforma as bordas em gestos, um por chamada:
+// - INPUT_PRESS: toque curto, ao soltar;
+// - INPUT_DOUBLE: segundo toque curto até INPUT_DOUBLE_US depois do primeiro (no
+//   lugar do segundo INPUT_PRESS; o primeiro já foi entregue, sem esperar);
+// - INPUT_LONG: botão mantido por INPUT_LONG_US, entregue sem esperar soltar (o
+//   toque então não gera INPUT_PRESS).
+// Cada borda é tratada uma vez; toques repetidos entre duas leituras não se fundem.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define INPUT_RING_SIZE 32 // Potência de 2
+#define INPUT_MAX_PINS 4
+#define INPUT_DEBOUNCE_US 20000
+#define INPUT_LONG_US 800000
+#define INPUT_DOUBLE_US 400000
+
+typedef enum
+{
+  INPUT_PRESS = 0,
+  INPUT_DOUBLE,
+  INPUT_LONG
+} InputKind;
+
+typedef struct
+{
+  uint8_t pin;
+  InputKind kind;
+  uint32_t time_us; // Instante da borda que completou o gesto
+} InputEvent;
+
+// Borda aceita pela interrupção
+typedef struct
+{
+  uint8_t pin;
+  bool pressed;
+  uint32_t time_us;
+} InputEdge;
+
+typedef struct
+{
+  // Lado da interrupção
+  bool primed;        // Já houve uma borda aceita
+  uint32_t last_us;   // Última borda aceita
+  // Lado do consumidor
+  bool down;
+  bool swallow;       // Toque já entregue como INPUT_LONG ou descartado
+  bool click_pending; // Houve um toque curto que pode virar duplo
+  uint32_t down_us;
+  uint32_t click_us;  // Fim do último toque curto
+} InputPin;
+
+typedef struct
+{
+  InputEdge ring[INPUT_RING_SIZE];
+  volatile uint32_t head; // Próxima posição a escrever (interrupção)
+  volatile uint32_t tail; // Próxima posição a ler (consumidor)
+  uint8_t pins[INPUT_MAX_PINS];
+  InputPin state[INPUT_MAX_PINS];
+  uint8_t count;
+  volatile uint32_t bounces; // Bordas descartadas pelo debounce
+  volatile uint32_t dropped; // Bordas perdidas com o anel cheio
+} InputQueue;
+
+void input_init(InputQueue *q, const uint8_t *pins, uint8_t count)
+{
+  memset(q, 0, sizeof(*q));
+  q->count = count > INPUT_MAX_PINS ? INPUT_MAX_PINS : count;
+  for (uint8_t i = 0; i < q->count; i++)
+    q->pins[i] = pins[i];
+}
+
+static inline int input_slot(const InputQueue *q, uint8_t pin)
+{
+  for (uint8_t i = 0; i < q->count; i++)
+    if (q->pins[i] == pin)
+      return i;
+  return -1;
+}
+
+// Chamada da interrupção: uma borda do pino (pressed = contato fechado)
+void input_isr(InputQueue *q, uint8_t pin, bool pressed, uint32_t now_us)
+{
+  int slot = input_slot(q, pin);
+  if (slot < 0)
+    return;
+  InputPin *p = &q->state[slot];
+  if (p->primed && now_us - p->last_us < INPUT_DEBOUNCE_US)
+  {
+    q->bounces = q->bounces + 1;
+    return;
+  }
+  p->primed = true;
+  p->last_us = now_us;
+
+  uint32_t head = q->head;
+  if (head - q->tail >= INPUT_RING_SIZE)
+  {
+    q->dropped = q->dropped + 1;
+    return;
+  }
+  InputEdge *e = &q->ring[head % INPUT_RING_SIZE];
+  e->pin = pin;
+  e->pressed = pressed;
+  e->time_us = now_us;
+  hal_dmb();
+  q->head = head + 1;
+}
+
+// Há bordas na fila ou botão mantido (conta como entrada do usuário)
+bool input_busy(const InputQueue *q)
+{
+  if (q->head != q->tail)
+    return true;
+  for (uint8_t i = 0; i < q->count; i++)
+    if (q->state[i].down)
+      return true;
+  return false;
+}
+
+// Retira a borda mais antiga da fila
+static inline bool input_pop(InputQueue *q, InputEdge *e)
+{
+  uint32_t tail = q->tail;
+  if (q->head == tail)
+    return false;
+  hal_dmb();
+  *e = q->ring[tail % INPUT_RING_SIZE];
+  hal_dmb();
+  q->tail = tail + 1;
+  return true;
+}
+
+// Aplica uma borda ao estado do pino. Retorna true e preenche ev se ela completa um gesto.
+static bool input_edge(InputQueue *q, const InputEdge *e, InputEvent *ev)
+{
+  InputPin *p = &q->state[input_slot(q, e->pin)];
+  if (e->pressed)
+  {
+    // Um toque novo (ou a volta de um soltar perdido) recomeça a contagem
+    p->down = true;
+    p->swallow = false;
+    p->down_us = e->time_us;
+    return false;
+  }
+  if (!p->down)
+    return false;
+  p->down = false;
+  if (p->swallow)
+    return false;
+
+  ev->pin = e->pin;
+  ev->time_us = e->time_us;
+  if (e->time_us - p->down_us >= INPUT_LONG_US)
+  {
+    // A fila ficou parada durante um toque longo inteiro
+    p->click_pending = false;
+    ev->kind = INPUT_LONG;
+  }
+  else if (p->click_pending && e->time_us - p->click_us <= INPUT_DOUBLE_US)
+  {
+    p->click_pending = false;
+    ev->kind = INPUT_DOUBLE;
+  }
+  else
+  {
+    p->click_pending = true;
+    p->click_us = e->time_us;
+    ev->kind = INPUT_PRESS;
+  }
+  return true;
+}
+
+// Próximo gesto até now_us. Retorna false quando não há mais nenhum.
+bool input_next(InputQueue *q, uint32_t now_us, InputEvent *ev)
+{
+  InputEdge e;
+  while (input_pop(q, &e))
+    if (input_edge(q, &e, ev))
+      return true;
+
+  // Fila vazia: um pino parado fora da janela do debounce com nível diferente do
+  // estado teve a última borda descartada; ela é recriada no fim da janela. Uma
+  // borda real que chegue depois desta leitura só repete o estado e é ignorada.
+  for (uint8_t i = 0; i < q->count; i++)
+  {
+    InputPin *p = &q->state[i];
+    uint32_t last_us = p->last_us;
+    if (!p->primed || now_us - last_us < INPUT_DEBOUNCE_US)
+      continue;
+    bool pressed = !hal_gpio_get(q->pins[i]);
+    if (pressed == p->down)
+      continue;
+    e.pin = q->pins[i];
+    e.pressed = pressed;
+    e.time_us = last_us + INPUT_DEBOUNCE_US;
+    if (input_edge(q, &e, ev))
+      return true;
+  }
+
+  for (uint8_t i = 0; i < q->count; i++)
+  {
+    InputPin *p = &q->state[i];
+    if (p->down && !p->swallow && now_us - p->down_us >= INPUT_LONG_US)
+    {
+      p->swallow = true;
+      p->click_pending = false;
+      ev->pin = q->pins[i];
+      ev->kind = INPUT_LONG;
+      ev->time_us = now_us;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Descarta as bordas na fila e os toques em andamento (a entrada que acordou o display)
+void input_discard(InputQueue *q)
+{
+  InputEdge e;
+  while (input_pop(q, &e))
+    q->state[input_slot(q, e.pin)].down = e.pressed;
+  for (uint8_t i = 0; i < q->count; i++)
+  {
+    q->state[i].swallow = q->state[i].down;
+    q->state[i].click_pending = false;
+  }
+}
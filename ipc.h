@@ -0,0 +1,80 @@
+// Comunicação entre os dois núcleos sem travas.
+//
+// Contrato de ordem de memória (Cortex-M0+ não reordena acessos, mas o compilador
+// sim; hal_dmb() é barreira de hardware e de compilador):
+//
+// - Seqlock (núcleo 1 -> núcleo 0): um único escritor. O contador é ímpar durante a
+//   escrita. O escritor faz seq++, hal_dmb(), copia os dados, hal_dmb(), seq++. O leitor
+//   lê seq, hal_dmb(), copia, hal_dmb(), relê seq e repete se mudou ou se era ímpar.
+//   O leitor nunca bloqueia o escritor, só tenta de novo.
+//
+// - Fila SPSC (núcleo 0 -> núcleo 1): head só é escrito pelo produtor e tail só pelo
+//   consumidor. O produtor grava o item e só depois (após hal_dmb()) publica head; o
+//   consumidor lê o item e só depois publica tail. Cada índice é uma palavra de
+//   32 bits, lida e escrita atomicamente.
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct
+{
+  volatile uint32_t seq;
+} SeqLock;
+
+// Publica n bytes de src em dst (só o núcleo escritor chama)
+static inline void seqlock_write(SeqLock *lock, void *dst, const void *src, size_t n)
+{
+  lock->seq = lock->seq + 1;
+  hal_dmb();
+  memcpy(dst, src, n);
+  hal_dmb();
+  lock->seq = lock->seq + 1;
+}
+
+// Copia um retrato consistente de src para dst
+static inline void seqlock_read(const SeqLock *lock, void *dst, const void *src, size_t n)
+{
+  uint32_t before, after;
+  do
+  {
+    before = lock->seq;
+    hal_dmb();
+    memcpy(dst, src, n);
+    hal_dmb();
+    after = lock->seq;
+  } while ((before & 1) || before != after);
+}
+
+#define SPSC_SIZE 16 // Potência de 2
+
+typedef struct
+{
+  uint32_t items[SPSC_SIZE];
+  volatile uint32_t head; // Próxima posição a escrever (produtor)
+  volatile uint32_t tail; // Próxima posição a ler (consumidor)
+} SpscQueue;
+
+// Retorna false se a fila estiver cheia
+static inline bool spsc_push(SpscQueue *q, uint32_t item)
+{
+  uint32_t head = q->head;
+  if (head - q->tail >= SPSC_SIZE)
+    return false;
+  q->items[head % SPSC_SIZE] = item;
+  hal_dmb();
+  q->head = head + 1;
+  return true;
+}
+
+// Retorna false se a fila estiver vazia
+static inline bool spsc_pop(SpscQueue *q, uint32_t *item)
+{
+  uint32_t tail = q->tail;
+  if (q->head == tail)
+    return false;
+  hal_dmb();
+  *item = q->items[tail % SPSC_SIZE];
+  hal_dmb();
+  q->tail = tail + 1;
+  return true;
+}
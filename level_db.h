@@ -0,0 +1,85 @@
+// Conversão de energia para nível sonoro (centésimos de dB) só com inteiros.
+//
+// O nível vem de 10 log10(energia / amostras) = 10 log10(2) (log2(E) - log2(N)), então
+// nem a divisão nem a raiz quadrada do RMS são necessárias. log2 é calculado pela
+// posição do bit mais alto mais a mantissa, consultada em uma tabela de
+// LEVEL_LOG2_SEGMENTS + 1 pontos (Q16) com interpolação linear. A tabela é
+// construída em tempo de compilação (constexpr) e fica em flash.
+//
+// Erro máximo no pior caso:
+//   interpolação (mantissa perto de 1, onde a curvatura é maior):
+//     10 log10(2) / (8 ln 2 * 32^2) = 0.00053 dB
+//   arredondamento da tabela (Q16) e do resultado (centi-dB): 0.0051 dB
+// Total abaixo de 0.006 dB (medido contra log10 em dupla precisão: 0.0055 dB com o
+// arredondamento do próprio centi-dB), bem dentro do limite de 0.05 dB.
+
+#include <stdint.h>
+
+#define LEVEL_LOG2_BITS 5
+#define LEVEL_LOG2_SEGMENTS (1 << LEVEL_LOG2_BITS)
+
+// 1000 log10(2) em Q16: converte log2 (Q16) em centi-dB de potência
+#define LEVEL_CDB_PER_LOG2_Q16 19728302LL
+
+// ln(x) para x em [1, 2] pela série de atanh: ln x = 2 sum z^(2k+1) / (2k+1), z = (x-1)/(x+1)
+static constexpr double level_ln(double x)
+{
+  double z = (x - 1.0) / (x + 1.0);
+  double z2 = z * z, term = z, sum = 0.0;
+  for (int k = 0; k < 20; k++)
+  {
+    sum += term / (2 * k + 1);
+    term *= z2;
+  }
+  return 2.0 * sum;
+}
+
+struct LevelLog2Table
+{
+  int32_t v[LEVEL_LOG2_SEGMENTS + 1];
+};
+
+static constexpr LevelLog2Table level_make_log2_table()
+{
+  LevelLog2Table t = {};
+  for (int i = 0; i <= LEVEL_LOG2_SEGMENTS; i++)
+  {
+    double log2 = level_ln(1.0 + (double)i / LEVEL_LOG2_SEGMENTS) / 0.69314718055994531;
+    t.v[i] = (int32_t)(log2 * 65536.0 + 0.5);
+  }
+  return t;
+}
+
+// log2(1 + i / 32) em Q16
+static constexpr LevelLog2Table level_log2_table = level_make_log2_table();
+
+static_assert(level_log2_table.v[0] == 0, "log2(1) deve ser 0");
+static_assert(level_log2_table.v[LEVEL_LOG2_SEGMENTS] == 65536, "log2(2) deve ser 1");
+
+// log2(x) em Q16 (x > 0)
+static inline int32_t level_log2_q16(uint64_t x)
+{
+  int e = 63 - __builtin_clzll(x);
+  // Mantissa com o bit mais alto na posição 31
+  uint32_t m = e >= 31 ? (uint32_t)(x >> (e - 31)) : (uint32_t)x << (31 - e);
+  uint32_t idx = (m >> (31 - LEVEL_LOG2_BITS)) & (LEVEL_LOG2_SEGMENTS - 1);
+  uint32_t frac = (m >> (31 - LEVEL_LOG2_BITS - 16)) & 0xFFFF;
+  int32_t a = level_log2_table.v[idx];
+  int32_t b = level_log2_table.v[idx + 1];
+  return (e << 16) + a + (int32_t)(((uint32_t)(b - a) * frac) >> 16);
+}
+
+// Converte log2 (Q16) em centi-dB de potência, com arredondamento
+static inline int32_t level_cdb_from_log2(int32_t log2_q16)
+{
+  return (int32_t)(((int64_t)log2_q16 * LEVEL_CDB_PER_LOG2_Q16 + (1LL << 31)) >> 32);
+}
+
+// Nível em centi-dB da média quadrática energy / count, mais offset_cdb (calibração).
+// Retorna 0 sem energia, como get_intensity() com tensão nula.
+static inline int32_t level_cdb_from_energy(uint64_t energy, uint64_t count, int32_t offset_cdb)
+{
+  if (energy == 0 || count == 0)
+    return 0;
+  return level_cdb_from_log2(level_log2_q16(energy) - level_log2_q16(count)) + offset_cdb;
+}
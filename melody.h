@@ -0,0 +1,93 @@
+// Sequenciador de melodias para os buzzers, sem bloquear o laço principal.
+//
+// Cada nota é agendada por um alarme de tempo (hal_alarm_in_ms): o callback roda na
+// interrupção do timer, troca a frequência do PWM e devolve o tempo até o próximo
+// evento. Enquanto isso a captura, a dose e a interface continuam rodando.
+
+#define MELODY_NOTE_GAP_MS 50    // Silêncio entre notas (como em play_tone)
+#define MELODY_REPEAT_GAP_MS 500 // Pausa antes de repetir uma melodia em laço
+
+typedef struct
+{
+  uint pin;
+  const Note *notes;
+  int num_notes;
+  int index;         // Nota atual
+  bool in_gap;       // true durante o silêncio após a nota
+  bool repeat;       // Recomeça ao terminar
+  hal_alarm_id_t alarm;
+  volatile bool playing;
+} MelodyState;
+
+static MelodyState melody = {};
+
+// Avança a melodia; retorna o atraso até o próximo evento (negativo = contado a partir
+// do agendamento anterior, para as durações não acumularem atraso)
+static int64_t melody_alarm_cb(hal_alarm_id_t id, void *user_data)
+{
+  if (!melody.playing)
+    return 0;
+
+  if (!melody.in_gap)
+  {
+    // Fim da nota: silêncio entre notas (pausas já são silêncio e não têm intervalo)
+    hal_buzzer_tone(melody.pin, 0);
+    melody.in_gap = true;
+
+    int64_t gap_ms = melody.notes[melody.index].frequency == 0 ? 0 : MELODY_NOTE_GAP_MS;
+    if (melody.index + 1 >= melody.num_notes)
+    {
+      if (!melody.repeat)
+      {
+        melody.playing = false;
+        return 0;
+      }
+      gap_ms += MELODY_REPEAT_GAP_MS;
+    }
+    if (gap_ms > 0)
+      return -gap_ms * 1000;
+  }
+
+  // Começa a próxima nota
+  melody.in_gap = false;
+  melody.index = (melody.index + 1) % melody.num_notes;
+  const Note *note = &melody.notes[melody.index];
+  hal_buzzer_tone(melody.pin, note->frequency);
+  return -(int64_t)note->duration * 1000;
+}
+
+// Para a melodia em andamento e silencia o buzzer
+void melody_stop()
+{
+  if (melody.playing)
+  {
+    melody.playing = false;
+    hal_alarm_cancel(melody.alarm);
+  }
+  if (melody.notes)
+    hal_buzzer_tone(melody.pin, 0);
+}
+
+// Começa a tocar as notas em segundo plano; com repeat, toca em laço até melody_stop()
+void melody_start(uint pin, const Note notes[], int num_notes, bool repeat)
+{
+  melody_stop();
+  if (num_notes <= 0)
+    return;
+
+  melody.pin = pin;
+  melody.notes = notes;
+  melody.num_notes = num_notes;
+  melody.index = 0;
+  melody.in_gap = false;
+  melody.repeat = repeat;
+  melody.playing = true;
+
+  hal_buzzer_tone(pin, notes[0].frequency);
+  melody.alarm = hal_alarm_in_ms(notes[0].duration, melody_alarm_cb, NULL);
+}
+
+bool melody_is_playing()
+{
+  return melody.playing;
+}
@@ -0,0 +1,148 @@
+// Captura contínua do microfone: o ADC (pela HAL, hal.h) escreve as amostras em um
+// buffer circular sem intervenção da CPU. O consumo é feito em blocos de tamanho
+// fixo, entregues a um callback fora de interrupção por mic_capture_service().
+//
+// Outros canais (o joystick) entram na mesma captura pelo modo round-robin do ADC:
+// cada quadro do anel tem uma conversão do microfone seguida de uma de cada canal
+// auxiliar, e o ADC roda a MIC_SAMPLE_RATE_HZ vezes o tamanho do quadro. O
+// microfone continua com amostras igualmente espaçadas, sem lacunas; o callback
+// recebe só as dele, já separadas. Os canais auxiliares são lidos direto do anel
+// por mic_capture_aux(), de qualquer núcleo.
+//
+// Os quadros começam nos números de conversão múltiplos do tamanho do quadro. Uma
+// conversão perdida (estouro da FIFO do ADC, por exemplo com as interrupções do
+// núcleo 1 presas durante a gravação da flash) deslocaria o microfone para as
+// posições do joystick dali em diante; por isso o estouro recomeça a captura no
+// início de um quadro (hal_mic_restart) e descarta o que ainda não foi consumido.
+
+// Taxa de amostragem do microfone (Hz)
+#ifndef MIC_SAMPLE_RATE_HZ
+#define MIC_SAMPLE_RATE_HZ 32000
+#endif
+
+#define MIC_BLOCK_SAMPLES 512 // Amostras entregues por bloco (16 ms a 32 kHz)
+
+// O buffer circular precisa ter tamanho potência de 2 e estar alinhado ao próprio
+// tamanho para usar o "ring" de escrita do DMA: 2^15 bytes = 16384 conversões, 170 ms
+// com o microfone e os dois eixos do joystick
+#define MIC_RING_BITS 15
+#define MIC_RING_BYTES (1u << MIC_RING_BITS)
+#define MIC_RING_SAMPLES (MIC_RING_BYTES / sizeof(uint16_t))
+#define MIC_ADC_CHANNELS 5
+
+typedef void (*mic_block_cb_t)(const uint16_t *samples, uint32_t count);
+
+typedef struct
+{
+  uint64_t captured;      // Amostras escritas pelo DMA desde o início
+  uint64_t processed;     // Amostras entregues ao callback
+  uint64_t lost;          // Amostras sobrescritas antes de serem consumidas
+  uint32_t overruns;      // Quantas vezes o consumidor ficou para trás
+  uint32_t fifo_overflows; // Estouros da FIFO do ADC (DMA não acompanhou)
+} MicCaptureStats;
+
+static uint16_t mic_ring[MIC_RING_SAMPLES] __attribute__((aligned(MIC_RING_BYTES)));
+static uint16_t mic_block[MIC_BLOCK_SAMPLES]; // Amostras do microfone de um bloco, separadas
+static MicCaptureStats mic_stats = {};
+static uint64_t mic_processed_raw = 0; // Conversões do anel já consumidas
+
+// Quadro do round-robin: tamanho e posição de cada canal auxiliar (0 = fora dele).
+// Definidos antes de a captura começar; o núcleo 0 só os lê depois disso.
+static volatile uint32_t mic_frame_len = 0;
+static uint8_t mic_aux_slot[MIC_ADC_CHANNELS];
+
+// Inicia a captura contínua no canal do microfone, intercalando os canais de aux_mask
+// (bit n = canal n). A HAL põe o microfone primeiro no quadro e os demais em ordem
+// crescente de canal a partir dele, como o round-robin do RP2040.
+void mic_capture_init(uint8_t adc_channel, uint8_t aux_mask)
+{
+  aux_mask &= ~(1u << adc_channel);
+  uint32_t slot = 1;
+  for (uint32_t i = 1; i < MIC_ADC_CHANNELS; i++)
+  {
+    uint8_t ch = (adc_channel + i) % MIC_ADC_CHANNELS;
+    mic_aux_slot[ch] = (aux_mask >> ch) & 1 ? slot++ : 0;
+  }
+  mic_aux_slot[adc_channel] = 0;
+  mic_frame_len = slot;
+  hal_mic_start(adc_channel, aux_mask, mic_ring, MIC_RING_BITS, MIC_SAMPLE_RATE_HZ);
+}
+
+// Entrega ao callback todos os blocos completos ainda não consumidos.
+// Retorna o número de blocos processados.
+uint32_t mic_capture_service(mic_block_cb_t cb)
+{
+  // Contas em conversões do anel; as estatísticas saem em amostras do microfone
+  uint32_t frame = mic_frame_len;
+  if (hal_mic_fifo_overflow())
+  {
+    // Depois da conversão perdida o anel pode estar desalinhado: as conversões ainda
+    // não consumidas contam como perdidas e o consumo segue do recomeço
+    uint64_t start = hal_mic_restart(frame);
+    mic_stats.fifo_overflows++;
+    mic_stats.lost += (start - mic_processed_raw) / frame;
+    mic_processed_raw = start;
+  }
+
+  uint32_t raw_block = MIC_BLOCK_SAMPLES * frame;
+  uint64_t captured = hal_mic_captured();
+  mic_stats.captured = captured / frame;
+
+  // Se o atraso chegou perto de uma volta completa, o bloco mais antigo já pode estar
+  // sendo sobrescrito: descarta o necessário, deixando folga de um bloco para o DMA
+  uint64_t lag = captured - mic_processed_raw;
+  if (lag > MIC_RING_SAMPLES - raw_block)
+  {
+    uint64_t skip = lag - (MIC_RING_SAMPLES - 2 * raw_block);
+    skip = (skip + raw_block - 1) / raw_block * raw_block;
+    mic_processed_raw += skip;
+    mic_stats.lost += skip / frame;
+    mic_stats.overruns++;
+  }
+
+  uint32_t blocks = 0;
+  while (captured - mic_processed_raw >= raw_block)
+  {
+    // O bloco pode dar a volta no anel (16384 não é múltiplo de 3 * 512)
+    uint64_t k = mic_processed_raw;
+    for (uint32_t i = 0; i < MIC_BLOCK_SAMPLES; i++, k += frame)
+      mic_block[i] = mic_ring[k % MIC_RING_SAMPLES];
+    cb(mic_block, MIC_BLOCK_SAMPLES);
+    mic_processed_raw += raw_block;
+    blocks++;
+  }
+  mic_stats.processed = mic_processed_raw / frame;
+  return blocks;
+}
+
+// Tempo até o próximo bloco completo (us), para o consumidor dormir até lá
+uint32_t mic_capture_us_to_next_block()
+{
+  uint32_t frame = mic_frame_len;
+  uint64_t pending = (hal_mic_captured() - mic_processed_raw) / frame;
+  if (pending >= MIC_BLOCK_SAMPLES)
+    return 0;
+  uint32_t missing = MIC_BLOCK_SAMPLES - (uint32_t)pending;
+  return (missing * 1000000u + MIC_SAMPLE_RATE_HZ - 1) / MIC_SAMPLE_RATE_HZ;
+}
+
+// Média das últimas n conversões de um canal auxiliar (n <= 64), lida do anel sem
+// parar o ADC. Quadros recém-escritos ainda levam 170 ms para ser sobrescritos, então
+// a leitura não precisa de trava. Antes da captura começar, devolve o meio da escala.
+uint16_t mic_capture_aux(uint8_t adc_channel, uint32_t n)
+{
+  uint32_t frame = mic_frame_len;
+  uint8_t slot = adc_channel < MIC_ADC_CHANNELS ? mic_aux_slot[adc_channel] : 0;
+  uint64_t frames = frame ? hal_mic_captured() / frame : 0;
+  if (slot == 0 || frames < n || n == 0)
+    return 2048;
+  uint32_t sum = 0;
+  for (uint64_t f = frames - n; f < frames; f++)
+    sum += mic_ring[(f * frame + slot) % MIC_RING_SAMPLES];
+  return (uint16_t)((sum + n / 2) / n);
+}
+
+MicCaptureStats mic_capture_get_stats()
+{
+  return mic_stats;
+}
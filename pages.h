@@ -0,0 +1,122 @@
+// Páginas da interface descritas por tabela, sem dependência de hardware.
+//
+// Cada página declara a função que a desenha no buffer, os dados de que depende
+// (PAGE_DEP_*) e o intervalo mínimo entre redesenhos. Quem chama marca os dados que
+// mudaram (pages_touch) e, a cada quadro, pages_frame() decide se a página visível
+// precisa ser redesenhada:
+// - troca de página ou pages_invalidate(): sempre;
+// - ajuste da página (PAGE_DEP_SETTINGS, um SEL): na hora, para a resposta ao toque;
+// - outro dado de que ela depende: no máximo a cada refresh_us.
+// Sem nada disso o buffer e o display ficam como estão: nenhum desenho e nenhum
+// byte no I2C. Uma página com cache (páginas estáticas) é desenhada uma vez; nas
+// visitas seguintes o quadro é copiado do cache.
+//
+// Só a página visível é desenhada, e pages_deps() diz a quem chama que dados ela
+// usa, para não calcular os das outras. Uma página nova é só uma linha na tabela.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define PAGE_DEP_MEASUREMENT (1u << 0) // Retrato novo do núcleo 1
+#define PAGE_DEP_HISTORY (1u << 1)     // Coluna nova no histórico do nível
+#define PAGE_DEP_BANDS (1u << 2)       // Leq das bandas (calculado só se alguma página visível depende dele)
+#define PAGE_DEP_ALARMS (1u << 3)      // Estado e contadores dos alarmes
+#define PAGE_DEP_SETTINGS (1u << 4)    // Ajuste da página (ação do SEL)
+
+typedef struct
+{
+  uint8_t id;
+  void (*draw)(uint8_t *buf); // Desenha o quadro inteiro no buffer
+  uint32_t refresh_us;        // Intervalo mínimo entre redesenhos por dados
+  uint32_t deps;              // PAGE_DEP_*
+  void (*select)();           // Ação do SEL nesta página (NULL = nenhuma)
+  uint8_t *cache;             // Quadro guardado de uma página estática (NULL = sem cache)
+} PageDef;
+
+typedef struct
+{
+  const PageDef *pages;
+  uint8_t count;
+  size_t frame_len;
+  const PageDef *shown; // Página do quadro atual do buffer (NULL = nenhuma)
+  uint64_t drawn_us;
+  uint32_t dirty;       // PAGE_DEP_* que mudaram desde o último desenho
+  uint32_t cached;      // Bit i: o cache da página i está pronto
+  uint32_t draws;       // Quadros desenhados e copiados do cache
+  uint32_t cache_hits;
+} PageView;
+
+void pages_init(PageView *v, const PageDef *pages, uint8_t count, size_t frame_len)
+{
+  memset(v, 0, sizeof(*v));
+  v->pages = pages;
+  v->count = count;
+  v->frame_len = frame_len;
+}
+
+// Página com o id; uma desconhecida vira a primeira da tabela
+static inline const PageDef *pages_find(const PageView *v, uint8_t id)
+{
+  for (uint8_t i = 0; i < v->count; i++)
+    if (v->pages[i].id == id)
+      return &v->pages[i];
+  return &v->pages[0];
+}
+
+static inline void pages_touch(PageView *v, uint32_t deps)
+{
+  v->dirty |= deps;
+}
+
+// O buffer deixou de ter o quadro da página (outra tela foi desenhada por cima)
+static inline void pages_invalidate(PageView *v)
+{
+  v->shown = NULL;
+}
+
+static inline uint32_t pages_deps(const PageView *v, uint8_t id)
+{
+  return pages_find(v, id)->deps;
+}
+
+// Executa a ação do SEL da página, se ela tiver uma
+void pages_select(PageView *v, uint8_t id)
+{
+  const PageDef *p = pages_find(v, id);
+  if (!p->select)
+    return;
+  p->select();
+  pages_touch(v, PAGE_DEP_SETTINGS);
+}
+
+// Atualiza buf com a página id, se preciso. Retorna true se buf tem um quadro novo.
+bool pages_frame(PageView *v, uint8_t id, uint64_t now_us, uint8_t *buf)
+{
+  const PageDef *p = pages_find(v, id);
+  uint32_t changed = v->dirty & p->deps;
+  if (p == v->shown && !(changed & PAGE_DEP_SETTINGS) &&
+      (!changed || now_us - v->drawn_us < p->refresh_us))
+    return false;
+
+  uint32_t bit = 1u << (p - v->pages);
+  if (p->cache && (v->cached & bit))
+  {
+    memcpy(buf, p->cache, v->frame_len);
+    v->cache_hits++;
+  }
+  else
+  {
+    p->draw(buf);
+    if (p->cache)
+    {
+      memcpy(p->cache, buf, v->frame_len);
+      v->cached |= bit;
+    }
+  }
+  v->draws++;
+  v->shown = p;
+  v->drawn_us = now_us;
+  v->dirty = 0;
+  return true;
+}
@@ -0,0 +1,161 @@
+// Modo de baixo consumo e estimativa do consumo, sem dependência de hardware.
+//
+// Com o modo ligado, o núcleo 0 decide a cada quadro:
+// - Relógio: o clk_sys cai para POWER_CLOCK_LOW_KHZ quando a carga do núcleo 1
+//   (tempo ocupado / duração do bloco), levada ao relógio baixo, fica abaixo de
+//   POWER_LOAD_DOWN_PERMILLE, e volta a POWER_CLOCK_FULL_KHZ quando passa de
+//   POWER_LOAD_UP_PERMILLE. A captura não é afetada: o ADC roda do clk_adc (PLL USB).
+// - Display: sem entrada do usuário por POWER_DIM_AFTER_S o contraste cai para
+//   POWER_CONTRAST_DIM; depois de POWER_BLANK_AFTER_S o painel é desligado (a RAM
+//   do SSD1306 é mantida) e os quadros deixam de ser enviados. Entrada ou alarme religa.
+// Sem o modo, relógio máximo e display sempre aceso, como antes.
+//
+// A estimativa soma correntes típicas de cada parte (valores de datasheet, na linha
+// de 3.3 V; para comparar configurações, não para substituir um medidor): o RP2040
+// proporcional ao relógio e à carga de cada núcleo, o OLED proporcional aos pixels
+// acesos e ao contraste, os LEDs e o buzzer. A carga acumulada em uma janela dá o
+// consumo médio em mW, que é também a energia por hora em mWh.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define POWER_CLOCK_FULL_KHZ 125000
+#define POWER_CLOCK_LOW_KHZ 48000
+#define POWER_LOAD_DOWN_PERMILLE 500 // Carga prevista no relógio baixo para descer
+#define POWER_LOAD_UP_PERMILLE 800   // Carga medida no relógio baixo para subir
+
+#define POWER_DIM_AFTER_S 30
+#define POWER_BLANK_AFTER_S 120
+#define POWER_CONTRAST_FULL 0xFF
+#define POWER_CONTRAST_DIM 0x08
+
+// Modelo de corrente (uA)
+#define POWER_SUPPLY_MV 3300
+#define POWER_UA_BASE 1500           // Flash, regulador, ADC e o resto da placa
+#define POWER_UA_PER_MHZ_CLOCKS 100  // Chip com os relógios rodando e os núcleos em WFE
+#define POWER_UA_PER_MHZ_CORE 60     // Cada núcleo, pelo tempo em que está ocupado
+#define POWER_UA_OLED_ON 400         // Controlador e bomba de carga com o painel ligado
+#define POWER_UA_OLED_FULL 20000     // Todos os pixels acesos em contraste máximo
+#define POWER_UA_OLED_SLEEP 10
+#define POWER_UA_LED 5000            // Cada canal do LED RGB aceso
+#define POWER_UA_BUZZER 2000
+
+typedef enum
+{
+  POWER_DISPLAY_ON = 0,
+  POWER_DISPLAY_DIM,
+  POWER_DISPLAY_OFF
+} PowerDisplay;
+
+typedef struct
+{
+  bool low_power;           // Modo de baixo consumo ligado
+  uint32_t clock_khz;       // Relógio atual do sistema
+  PowerDisplay display;     // Estado aplicado ao display
+  uint64_t last_input_us;   // Última entrada do usuário (ou alarme)
+  uint64_t last_account_us; // Último power_account()
+  uint64_t window_ua_us;    // Carga e duração da janela de power_window_mw_x10()
+  uint64_t window_us;
+} PowerState;
+
+// Retrato do que consome, montado por quem chama
+typedef struct
+{
+  uint32_t clock_khz;
+  uint16_t core0_load_permille;
+  uint16_t core1_load_permille;
+  uint16_t lit_permille; // Pixels acesos no quadro mostrado
+  uint8_t contrast;
+  bool display_on;
+  uint8_t leds_on;       // Canais do LED RGB acesos
+  bool buzzer_on;
+} PowerLoad;
+
+void power_init(PowerState *p, bool low_power, uint32_t clock_khz, uint64_t now_us)
+{
+  p->low_power = low_power;
+  p->clock_khz = clock_khz;
+  p->display = POWER_DISPLAY_ON;
+  p->last_input_us = now_us;
+  p->last_account_us = now_us;
+  p->window_ua_us = 0;
+  p->window_us = 0;
+}
+
+// Registra uma entrada do usuário. Retorna true se o display estava apagado, para
+// quem chama descartar a entrada que só serviu para acordá-lo.
+static inline bool power_input(PowerState *p, uint64_t now_us)
+{
+  p->last_input_us = now_us;
+  return p->display == POWER_DISPLAY_OFF;
+}
+
+// Estado que o display deve ter agora
+static inline PowerDisplay power_display_target(const PowerState *p, uint64_t now_us)
+{
+  if (!p->low_power)
+    return POWER_DISPLAY_ON;
+  uint64_t idle_us = now_us - p->last_input_us;
+  if (idle_us >= POWER_BLANK_AFTER_S * 1000000ull)
+    return POWER_DISPLAY_OFF;
+  if (idle_us >= POWER_DIM_AFTER_S * 1000000ull)
+    return POWER_DISPLAY_DIM;
+  return POWER_DISPLAY_ON;
+}
+
+// Relógio que o sistema deve ter, dada a carga do núcleo 1 medida no relógio atual
+static inline uint32_t power_clock_target(const PowerState *p, uint32_t load_permille)
+{
+  if (!p->low_power)
+    return POWER_CLOCK_FULL_KHZ;
+  if (p->clock_khz <= POWER_CLOCK_LOW_KHZ)
+    return load_permille > POWER_LOAD_UP_PERMILLE ? POWER_CLOCK_FULL_KHZ : p->clock_khz;
+  uint64_t scaled = (uint64_t)load_permille * p->clock_khz / POWER_CLOCK_LOW_KHZ;
+  return scaled < POWER_LOAD_DOWN_PERMILLE ? POWER_CLOCK_LOW_KHZ : p->clock_khz;
+}
+
+// Pixels acesos de um quadro, em milésimos
+static inline uint16_t power_lit_permille(const uint8_t *frame, size_t len)
+{
+  uint32_t lit = 0;
+  for (size_t i = 0; i < len; i++)
+    lit += __builtin_popcount(frame[i]);
+  return (uint16_t)(lit * 1000u / (len * 8));
+}
+
+// Corrente estimada (uA)
+uint32_t power_estimate_ua(const PowerLoad *l)
+{
+  uint32_t mhz = l->clock_khz / 1000;
+  uint32_t ua = POWER_UA_BASE + POWER_UA_PER_MHZ_CLOCKS * mhz;
+  ua += POWER_UA_PER_MHZ_CORE * mhz * (l->core0_load_permille + l->core1_load_permille) / 1000;
+  if (l->display_on)
+    ua += POWER_UA_OLED_ON + (uint32_t)((uint64_t)POWER_UA_OLED_FULL * l->lit_permille * (l->contrast + 1) / (1000 * 256));
+  else
+    ua += POWER_UA_OLED_SLEEP;
+  ua += POWER_UA_LED * l->leds_on;
+  if (l->buzzer_on)
+    ua += POWER_UA_BUZZER;
+  return ua;
+}
+
+// Acumula a corrente ua desde a chamada anterior
+static inline void power_account(PowerState *p, uint32_t ua, uint64_t now_us)
+{
+  uint64_t dt = now_us - p->last_account_us;
+  p->last_account_us = now_us;
+  p->window_ua_us += ua * dt;
+  p->window_us += dt;
+}
+
+// Consumo médio desde a chamada anterior, em décimos de mW (= décimos de mWh por hora)
+static inline uint32_t power_window_mw_x10(PowerState *p)
+{
+  if (p->window_us == 0)
+    return 0;
+  uint64_t ua = p->window_ua_us / p->window_us;
+  p->window_ua_us = 0;
+  p->window_us = 0;
+  return (uint32_t)(ua * POWER_SUPPLY_MV / 100000);
+}
@@ -0,0 +1,105 @@
+// Escalonador cooperativo por prazos, sem dependência de hardware.
+//
+// Cada tarefa roda até o fim (sem preempção) e tem período e prazo próprios. A
+// liberação k acontece em início + k * período, contada a partir da liberação
+// anterior e não do fim da execução, então o atraso de uma execução não se acumula
+// nas seguintes. A execução deve terminar até liberação + prazo; se terminar depois,
+// conta uma perda. Entre as tarefas liberadas roda a de prazo mais cedo (EDF).
+//
+// Uma tarefa atrasada mais de um período não recupera o atraso em rajada: as
+// liberações cujo prazo já passou são puladas e contadas como perdas, e a tarefa
+// volta à grade original.
+//
+// O relógio vem de quem chama (hal_time_us_64 no firmware, um relógio virtual em
+// tools/sched_test.cpp), e sched_step() devolve quanto falta até a próxima
+// liberação, para o laço principal dormir até lá.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct
+{
+  const char *name;
+  void (*run)();
+  uint32_t period_us;
+  // Os campos abaixo têm valor padrão, então a tabela de tarefas só dá nome, função,
+  // período e, se quiser, o prazo; sched_init() preenche o resto
+  uint32_t deadline_us = 0; // Relativo à liberação (0 = o período)
+  uint64_t release_us = 0;  // Próxima liberação
+  uint32_t runs = 0;
+  uint32_t misses = 0;      // Execuções fora do prazo e liberações puladas
+  uint32_t max_run_us = 0;  // Maior duração de uma execução
+} SchedTask;
+
+typedef struct
+{
+  SchedTask *tasks;
+  uint8_t count;
+  uint64_t (*now)();
+  uint64_t busy_us; // Tempo total dentro das tarefas
+} Scheduler;
+
+// Todas as tarefas são liberadas em start_us
+void sched_init(Scheduler *s, SchedTask *tasks, uint8_t count, uint64_t (*now)(), uint64_t start_us)
+{
+  s->tasks = tasks;
+  s->count = count;
+  s->now = now;
+  s->busy_us = 0;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    SchedTask *t = &tasks[i];
+    if (t->deadline_us == 0)
+      t->deadline_us = t->period_us;
+    t->release_us = start_us;
+    t->runs = t->misses = t->max_run_us = 0;
+  }
+}
+
+// Microssegundos até a próxima liberação (0 = há tarefa pronta)
+uint32_t sched_idle_us(const Scheduler *s)
+{
+  uint64_t now = s->now();
+  uint64_t next = UINT64_MAX;
+  for (uint8_t i = 0; i < s->count; i++)
+    if (s->tasks[i].release_us < next)
+      next = s->tasks[i].release_us;
+  if (next <= now)
+    return 0;
+  return next - now > UINT32_MAX ? UINT32_MAX : (uint32_t)(next - now);
+}
+
+// Roda a tarefa liberada de prazo mais cedo, se houver, e devolve sched_idle_us()
+uint32_t sched_step(Scheduler *s)
+{
+  uint64_t now = s->now();
+  SchedTask *best = NULL;
+  for (uint8_t i = 0; i < s->count; i++)
+  {
+    SchedTask *t = &s->tasks[i];
+    if (t->release_us <= now && (!best || t->release_us + t->deadline_us < best->release_us + best->deadline_us))
+      best = t;
+  }
+  if (!best)
+    return sched_idle_us(s);
+
+  best->run();
+  uint64_t end = s->now();
+  uint64_t run_us = end - now;
+  s->busy_us += run_us;
+  best->runs++;
+  if (run_us > best->max_run_us)
+    best->max_run_us = run_us > UINT32_MAX ? UINT32_MAX : (uint32_t)run_us;
+
+  uint64_t deadline = best->release_us + best->deadline_us;
+  if (end > deadline)
+    best->misses++;
+  best->release_us += best->period_us;
+  while (best->release_us + best->deadline_us <= end)
+  {
+    best->release_us += best->period_us;
+    best->misses++;
+  }
+  return sched_idle_us(s);
+}
@@ -0,0 +1,759 @@
+// Implementação da HAL (hal.h) para o Linux, usada pelo simulador (simis_sim.cpp).
+//
+// - Relógio virtual: hal_time_us_*() devolve sim.now_us, que só avança nas esperas
+//   (hal_sleep_*, espera do I2C) e no escalonador do simulador. O código roda em
+//   tempo zero de relógio virtual, então a simulação vai tão rápido quanto o host.
+// - Alarmes de tempo e eventos do roteiro (botões, joystick, sinal de entrada) são
+//   disparados em ordem de tempo por sim_advance_to().
+// - ADC: o canal do microfone vem de um arquivo de amostras cruas ou de um gerador
+//   (tom + ruído, nível em dB na escala de get_intensity()); os outros canais têm
+//   valores fixos alterados pelo roteiro (joystick).
+// - I2C: cada fluxo é decodificado por um SSD1306 emulado (comandos e dados no modo
+//   de endereçamento em uso), cuja RAM pode ser salva como imagem PBM. O tempo de
+//   barramento é estimado em 9 bits por byte na taxa configurada.
+// - Flash: imagem em memória com semântica NOR (apagar = 0xFF, gravar só zera bits),
+//   opcionalmente carregada e salva em arquivo.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#define HAL_CYCLES_MASK 0xFFFFFFFFu
+#define HAL_CYCLES_UNIT "ns"
+#define HAL_CYCLES_UNIT_SHORT "ns"
+#define HAL_TARGET_NAME "host"
+
+#define SIM_SYS_CLOCK_KHZ 125000 // clk_sys depois do boot, como no Pico SDK
+
+#define SIM_PINS 30
+#define SIM_ADC_CHANNELS 5
+#define SIM_ALARMS 8
+#define SIM_FLASH_SECTORS 64
+
+// Nível em dB de um sinal com 1 contagem RMS, como em get_intensity()
+#define SIM_DB_PER_COUNT (20.0 * log10(3.3 / 0.05))
+
+#define SIM_SSD1306_PAGES 8
+#define SIM_SSD1306_COLS 128
+
+typedef struct
+{
+  uint8_t ram[SIM_SSD1306_PAGES][SIM_SSD1306_COLS];
+  uint8_t mem_mode; // 0 horizontal, 1 vertical, 2 página
+  uint8_t col_start, col_end, page_start, page_end;
+  uint8_t col, page;
+  bool display_on, inverted, all_on;
+  uint8_t contrast;
+  uint8_t cmd[8]; // Comando em andamento e seus argumentos
+  int cmd_len, cmd_need;
+} SimSsd1306;
+
+typedef struct
+{
+  hal_alarm_cb_t cb;
+  void *user_data;
+  uint64_t due_us;
+  bool active;
+} SimAlarm;
+
+typedef struct
+{
+  uint64_t time_us;
+  std::function<void()> run;
+} SimEvent;
+
+struct
+{
+  uint64_t now_us;
+  uint32_t sys_khz; // Relógio do sistema: só registrado, o código roda em tempo zero
+
+  std::vector<SimEvent> events; // Roteiro, em ordem de tempo
+  size_t next_event;
+  SimAlarm alarms[SIM_ALARMS];
+
+  // GPIO
+  bool output[SIM_PINS];
+  bool level[SIM_PINS];
+  uint64_t pressed_until[SIM_PINS];
+  hal_gpio_irq_cb_t irq[SIM_PINS];
+  uint buzzer_hz[SIM_PINS];
+  FILE *events_log;
+
+  // ADC e sinal do microfone
+  uint16_t adc[SIM_ADC_CHANNELS];
+  std::vector<uint16_t> samples; // Amostras de arquivo (em laço); vazio = gerador
+  double tone_hz, tone_rms, noise_rms;
+  double bias; // Deslocamento da polarização do microfone (contagens)
+  uint32_t rng;
+  bool mic_running;
+  int mic_channel; // Canal do microfone (definido pelo simulador antes de setup())
+  uint16_t *mic_ring;
+  uint32_t mic_ring_samples;
+  uint32_t mic_rate_hz;
+  uint64_t mic_start_us;
+  uint64_t mic_base;        // Número da conversão no último (re)começo
+  uint64_t mic_sample_base; // Amostra do microfone no último (re)começo
+  uint32_t mic_skew;        // Conversões perdidas desde o último (re)começo
+  bool mic_overflow;
+  uint64_t mic_filled;
+  uint8_t mic_frame[SIM_ADC_CHANNELS]; // Canais de um quadro do round-robin, microfone primeiro
+  uint32_t mic_frame_len;
+
+  // I2C e display
+  uint32_t i2c_baud;
+  uint64_t i2c_busy_until;
+  uint32_t i2c_transfers;
+  uint64_t i2c_bytes;
+  FILE *i2c_log;
+  SimSsd1306 oled;
+
+  // Serial
+  FILE *serial_out;
+  std::string serial_in;
+
+  // Flash
+  std::vector<uint8_t> flash;
+  uint32_t flash_erases, flash_programs;
+  HalResetReason reset_reason; // Escolhida com -r
+
+  void (*core1_entry)();
+} sim;
+
+// ---- Relógio virtual e eventos ----
+
+// Avança o relógio até t, executando na ordem os alarmes e eventos do roteiro
+void sim_advance_to(uint64_t t)
+{
+  while (true)
+  {
+    uint64_t next = t;
+    int alarm = -1;
+    for (int i = 0; i < SIM_ALARMS; i++)
+      if (sim.alarms[i].active && sim.alarms[i].due_us <= next)
+      {
+        next = sim.alarms[i].due_us;
+        alarm = i;
+      }
+    bool event = sim.next_event < sim.events.size() && sim.events[sim.next_event].time_us <= next;
+    if (event)
+    {
+      next = sim.events[sim.next_event].time_us;
+      alarm = -1;
+    }
+    if (!event && alarm < 0)
+      break;
+
+    if (next > sim.now_us)
+      sim.now_us = next;
+    if (event)
+    {
+      std::function<void()> run = sim.events[sim.next_event++].run; // A ação pode agendar outras
+      run();
+      continue;
+    }
+
+    SimAlarm *a = &sim.alarms[alarm];
+    int64_t delay = a->cb(alarm + 1, a->user_data);
+    if (!a->active)
+      continue; // Cancelado pelo próprio callback
+    if (delay < 0)
+      a->due_us += (uint64_t)(-delay);
+    else if (delay > 0)
+      a->due_us = sim.now_us + delay;
+    else
+      a->active = false;
+  }
+  if (t > sim.now_us)
+    sim.now_us = t;
+}
+
+// Agenda uma ação (do roteiro, antes de começar, ou de outra ação), em qualquer ordem
+void sim_schedule(uint64_t time_us, std::function<void()> run)
+{
+  SimEvent ev = {time_us, run};
+  size_t i = sim.events.size();
+  sim.events.push_back(ev);
+  while (i > sim.next_event && sim.events[i - 1].time_us > time_us)
+  {
+    std::swap(sim.events[i - 1], sim.events[i]);
+    i--;
+  }
+}
+
+uint64_t hal_time_us_64()
+{
+  return sim.now_us;
+}
+
+uint32_t hal_time_us_32()
+{
+  return (uint32_t)sim.now_us;
+}
+
+void hal_sleep_ms(uint32_t ms)
+{
+  sim_advance_to(sim.now_us + ms * 1000ull);
+}
+
+void hal_sleep_us(uint64_t us)
+{
+  sim_advance_to(sim.now_us + us);
+}
+
+static void sim_log_event(const char *kind, uint pin, uint value);
+
+bool hal_set_sys_clock_khz(uint32_t khz)
+{
+  if (khz != sim.sys_khz)
+    sim_log_event("clock", 0, khz);
+  sim.sys_khz = khz;
+  return true;
+}
+
+uint32_t hal_sys_clock_khz()
+{
+  return sim.sys_khz;
+}
+
+hal_alarm_id_t hal_alarm_in_ms(uint32_t ms, hal_alarm_cb_t cb, void *user_data)
+{
+  for (int i = 0; i < SIM_ALARMS; i++)
+    if (!sim.alarms[i].active)
+    {
+      sim.alarms[i] = {cb, user_data, sim.now_us + ms * 1000ull, true};
+      return i + 1;
+    }
+  return -1;
+}
+
+void hal_alarm_cancel(hal_alarm_id_t id)
+{
+  if (id >= 1 && id <= SIM_ALARMS)
+    sim.alarms[id - 1].active = false;
+}
+
+// ---- GPIO e buzzer ----
+
+static void sim_log_event(const char *kind, uint pin, uint value)
+{
+  if (sim.events_log)
+    fprintf(sim.events_log, "%.3f,%s,%u,%u\n", sim.now_us / 1000.0, kind, pin, value);
+}
+
+void hal_gpio_output(uint pin)
+{
+  sim.output[pin] = true;
+  sim.level[pin] = false;
+}
+
+void hal_gpio_input_pullup(uint pin)
+{
+  sim.output[pin] = false;
+  sim.level[pin] = true;
+}
+
+void hal_gpio_irq_edges(uint pin, hal_gpio_irq_cb_t cb)
+{
+  sim.irq[pin] = cb;
+}
+
+void hal_gpio_put(uint pin, bool value)
+{
+  if (sim.level[pin] != value)
+    sim_log_event("gpio", pin, value);
+  sim.level[pin] = value;
+}
+
+bool hal_gpio_get(uint pin)
+{
+  if (!sim.output[pin] && sim.now_us < sim.pressed_until[pin])
+    return false;
+  return sim.level[pin];
+}
+
+static void sim_edge(uint pin, uint32_t events)
+{
+  if (sim.irq[pin])
+    sim.irq[pin](pin, events);
+}
+
+// Aperta um botão (entrada com pull-up) por ms milissegundos. Cada transição do
+// contato trepida: duas bordas extras no primeiro milissegundo.
+void sim_press(uint pin, uint32_t ms)
+{
+  uint64_t down = sim.now_us, up = down + ms * 1000ull;
+  sim.pressed_until[pin] = up;
+  sim_edge(pin, HAL_GPIO_EDGE_FALL);
+  sim_schedule(down + 300, [pin]() { sim_edge(pin, HAL_GPIO_EDGE_RISE); });
+  sim_schedule(down + 700, [pin]() { sim_edge(pin, HAL_GPIO_EDGE_FALL); });
+  sim_schedule(up, [pin]() { sim_edge(pin, HAL_GPIO_EDGE_RISE); });
+  sim_schedule(up + 400, [pin]() { sim_edge(pin, HAL_GPIO_EDGE_FALL); });
+  sim_schedule(up + 900, [pin]() { sim_edge(pin, HAL_GPIO_EDGE_RISE); });
+}
+
+void hal_buzzer_init(uint pin)
+{
+  sim.buzzer_hz[pin] = 0;
+}
+
+void hal_buzzer_tone(uint pin, uint frequency)
+{
+  if (sim.buzzer_hz[pin] != frequency)
+    sim_log_event("buzzer", pin, frequency);
+  sim.buzzer_hz[pin] = frequency;
+}
+
+// ---- ADC e sinal do microfone ----
+
+static double sim_gauss()
+{
+  // Box-Muller com um gerador congruencial, para a simulação ser reproduzível
+  sim.rng = sim.rng * 1664525u + 1013904223u;
+  double u1 = ((sim.rng >> 8) + 1.0) / 16777217.0;
+  sim.rng = sim.rng * 1664525u + 1013904223u;
+  double u2 = (sim.rng >> 8) / 16777216.0;
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+// Amostra k do microfone (k conta a partir do início da captura)
+static uint16_t sim_mic_sample(uint64_t k)
+{
+  if (!sim.samples.empty())
+    return sim.samples[k % sim.samples.size()];
+
+  double v = 2047.5 + sim.bias;
+  if (sim.tone_rms > 0.0)
+    v += sim.tone_rms * M_SQRT2 * sin(2.0 * M_PI * fmod(sim.tone_hz * k / sim.mic_rate_hz, 1.0));
+  if (sim.noise_rms > 0.0)
+    v += sim.noise_rms * sim_gauss();
+  return v < 0.0 ? 0 : v > 4095.0 ? 4095 : (uint16_t)lrint(v);
+}
+
+// Quadros do ADC desde o último (re)começo
+static uint64_t sim_mic_frames()
+{
+  return (sim.now_us - sim.mic_start_us) * sim.mic_rate_hz / 1000000u;
+}
+
+static uint64_t sim_mic_due()
+{
+  return sim.mic_base + sim_mic_frames() * sim.mic_frame_len;
+}
+
+// Escreve no anel as conversões até n (as que já teriam sido sobrescritas são
+// puladas): cada quadro do round-robin tem a amostra do microfone e os valores
+// atuais dos canais auxiliares. Depois de uma conversão perdida, a posição no quadro
+// do ADC fica adiantada em relação à do anel.
+static void sim_mic_fill(uint64_t n)
+{
+  if (n - sim.mic_filled > sim.mic_ring_samples)
+    sim.mic_filled = n - sim.mic_ring_samples;
+  for (; sim.mic_filled < n; sim.mic_filled++)
+  {
+    uint64_t a = sim.mic_filled - sim.mic_base + sim.mic_skew;
+    uint32_t slot = a % sim.mic_frame_len;
+    uint16_t v = slot == 0 ? sim_mic_sample(sim.mic_sample_base + a / sim.mic_frame_len) : sim.adc[sim.mic_frame[slot]];
+    sim.mic_ring[sim.mic_filled % sim.mic_ring_samples] = v;
+  }
+}
+
+// Perde uma conversão (estouro da FIFO do ADC) a partir de agora
+void sim_mic_drop()
+{
+  if (!sim.mic_running)
+    return;
+  sim_mic_fill(sim_mic_due());
+  sim.mic_skew++;
+  sim.mic_overflow = true;
+}
+
+static double sim_db_to_rms(double db)
+{
+  return db <= 0.0 ? 0.0 : pow(10.0, (db - SIM_DB_PER_COUNT) / 20.0);
+}
+
+// Troca o sinal do gerador a partir de agora (nível 0 = desligado)
+void sim_set_signal(double tone_hz, double tone_db, double noise_db)
+{
+  if (sim.mic_running)
+    sim_mic_fill(sim_mic_due());
+  sim.tone_hz = tone_hz;
+  sim.tone_rms = sim_db_to_rms(tone_db);
+  sim.noise_rms = sim_db_to_rms(noise_db);
+}
+
+// Troca a leitura de um canal auxiliar (joystick) a partir de agora
+void sim_set_adc(uint8_t channel, uint16_t value)
+{
+  if (sim.mic_running)
+    sim_mic_fill(sim_mic_due());
+  if (channel < SIM_ADC_CHANNELS)
+    sim.adc[channel] = value;
+}
+
+// Desloca a polarização do microfone a partir de agora (deriva, microfone trocado)
+void sim_set_bias(double counts)
+{
+  if (sim.mic_running)
+    sim_mic_fill(sim_mic_due());
+  sim.bias = counts;
+}
+
+void hal_adc_gpio_init(uint pin)
+{
+}
+
+void hal_adc_init()
+{
+}
+
+uint16_t hal_adc_read(uint8_t channel)
+{
+  if (channel == sim.mic_channel)
+    return sim_mic_sample(sim.now_us * (sim.mic_rate_hz ? sim.mic_rate_hz : 32000) / 1000000u);
+  return channel < SIM_ADC_CHANNELS ? sim.adc[channel] : 0;
+}
+
+void hal_mic_start(uint8_t channel, uint8_t aux_mask, uint16_t *ring, uint32_t ring_bits, uint32_t rate_hz)
+{
+  sim.mic_channel = channel;
+  sim.mic_frame[0] = channel;
+  sim.mic_frame_len = 1;
+  for (int i = 1; i < SIM_ADC_CHANNELS; i++)
+  {
+    int ch = (channel + i) % SIM_ADC_CHANNELS;
+    if ((aux_mask >> ch) & 1)
+      sim.mic_frame[sim.mic_frame_len++] = ch;
+  }
+  sim.mic_ring = ring;
+  sim.mic_ring_samples = (1u << ring_bits) / sizeof(uint16_t);
+  sim.mic_rate_hz = rate_hz;
+  sim.mic_start_us = sim.now_us;
+  sim.mic_base = 0;
+  sim.mic_sample_base = 0;
+  sim.mic_skew = 0;
+  sim.mic_overflow = false;
+  sim.mic_filled = 0;
+  sim.mic_running = true;
+}
+
+uint64_t hal_mic_captured()
+{
+  if (!sim.mic_running)
+    return 0;
+  uint64_t n = sim_mic_due();
+  sim_mic_fill(n);
+  return n;
+}
+
+bool hal_mic_fifo_overflow()
+{
+  bool overflow = sim.mic_overflow;
+  sim.mic_overflow = false;
+  return overflow;
+}
+
+uint64_t hal_mic_restart(uint32_t align)
+{
+  uint64_t start = hal_mic_captured();
+  start = (start + align - 1) / align * align;
+  sim.mic_sample_base += sim_mic_frames();
+  sim.mic_start_us = sim.now_us;
+  sim.mic_base = start;
+  sim.mic_skew = 0;
+  sim.mic_filled = start;
+  return start;
+}
+
+// ---- I2C e SSD1306 ----
+
+static int sim_ssd1306_args(uint8_t cmd)
+{
+  switch (cmd)
+  {
+  case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+    return 1;
+  case 0x21: case 0x22: case 0xA3:
+    return 2;
+  case 0x29: case 0x2A:
+    return 5;
+  case 0x26: case 0x27:
+    return 6;
+  default:
+    return 0;
+  }
+}
+
+static void sim_ssd1306_command(SimSsd1306 *d)
+{
+  uint8_t c = d->cmd[0];
+  if (c == 0x20)
+    d->mem_mode = d->cmd[1] & 3;
+  else if (c == 0x21)
+  {
+    d->col_start = d->col = d->cmd[1] & 0x7F;
+    d->col_end = d->cmd[2] & 0x7F;
+  }
+  else if (c == 0x22)
+  {
+    d->page_start = d->page = d->cmd[1] & 7;
+    d->page_end = d->cmd[2] & 7;
+  }
+  else if (c == 0xA4 || c == 0xA5)
+    d->all_on = c == 0xA5;
+  else if (c == 0xA6 || c == 0xA7)
+    d->inverted = c == 0xA7;
+  else if (c == 0xAE || c == 0xAF)
+  {
+    if (d->display_on != (c == 0xAF))
+      sim_log_event("oled_on", 0, c == 0xAF);
+    d->display_on = c == 0xAF;
+  }
+  else if (c == 0x81)
+  {
+    if (d->contrast != d->cmd[1])
+      sim_log_event("oled_contrast", 0, d->cmd[1]);
+    d->contrast = d->cmd[1];
+  }
+  else if (c >= 0xB0 && c <= 0xB7)
+    d->page = c & 7;
+  else if (c <= 0x0F)
+    d->col = (d->col & 0xF0) | c;
+  else if (c >= 0x10 && c <= 0x1F)
+    d->col = ((c & 0x0F) << 4) | (d->col & 0x0F);
+  // Rolagem, multiplex etc. não mudam a RAM e são ignorados
+}
+
+static void sim_ssd1306_data(SimSsd1306 *d, uint8_t b)
+{
+  d->ram[d->page][d->col] = b;
+  if (d->mem_mode == 0)
+  {
+    if (d->col++ >= d->col_end)
+    {
+      d->col = d->col_start;
+      d->page = d->page >= d->page_end ? d->page_start : d->page + 1;
+    }
+  }
+  else if (d->mem_mode == 1)
+  {
+    if (d->page++ >= d->page_end)
+    {
+      d->page = d->page_start;
+      d->col = d->col >= d->col_end ? d->col_start : d->col + 1;
+    }
+  }
+  else
+    d->col = (d->col + 1) & 0x7F;
+}
+
+// Uma transação: byte de controle (Co, D/C) seguido dos bytes
+static void sim_ssd1306_transaction(SimSsd1306 *d, const uint8_t *bytes, int n)
+{
+  int i = 0;
+  while (i < n)
+  {
+    uint8_t control = bytes[i++];
+    bool single = control & 0x80; // Co = 1: só um byte antes do próximo controle
+    bool data = control & 0x40;
+    int end = single ? (i + 1 < n ? i + 1 : n) : n;
+    for (; i < end; i++)
+    {
+      if (data)
+        sim_ssd1306_data(d, bytes[i]);
+      else
+      {
+        if (d->cmd_len == 0)
+          d->cmd_need = 1 + sim_ssd1306_args(bytes[i]);
+        d->cmd[d->cmd_len++] = bytes[i];
+        if (d->cmd_len == d->cmd_need)
+        {
+          sim_ssd1306_command(d);
+          d->cmd_len = 0;
+        }
+      }
+    }
+  }
+}
+
+// Pixel visível em (x, y), na orientação em que o firmware desenha
+static bool sim_ssd1306_pixel(const SimSsd1306 *d, int x, int y)
+{
+  if (!d->display_on)
+    return false;
+  if (d->all_on)
+    return true;
+  bool on = (d->ram[y / 8][x] >> (y % 8)) & 1;
+  return on != d->inverted;
+}
+
+// Salva o que o display mostra como PBM binário (P4)
+bool sim_ssd1306_write_pbm(const char *path)
+{
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return false;
+  fprintf(f, "P4\n%d %d\n", SIM_SSD1306_COLS, SIM_SSD1306_PAGES * 8);
+  for (int y = 0; y < SIM_SSD1306_PAGES * 8; y++)
+  {
+    uint8_t row[SIM_SSD1306_COLS / 8] = {0};
+    for (int x = 0; x < SIM_SSD1306_COLS; x++)
+      if (sim_ssd1306_pixel(&sim.oled, x, y))
+        row[x / 8] |= 0x80 >> (x % 8);
+    fwrite(row, 1, sizeof(row), f);
+  }
+  fclose(f);
+  return true;
+}
+
+void hal_i2c_init(uint sda_pin, uint scl_pin, uint32_t baud)
+{
+  sim.i2c_baud = baud;
+}
+
+void hal_i2c_stream_init(uint8_t addr)
+{
+  SimSsd1306 *d = &sim.oled;
+  memset(d, 0, sizeof(*d));
+  d->col_end = SIM_SSD1306_COLS - 1;
+  d->page_end = SIM_SSD1306_PAGES - 1;
+  d->mem_mode = 2; // Padrão do SSD1306 depois do reset
+  d->contrast = 0x7F;
+}
+
+void hal_i2c_stream_start(const uint16_t *words, uint32_t count)
+{
+  uint8_t bytes[2048];
+  int n = 0;
+  uint32_t transactions = 0;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (n < (int)sizeof(bytes))
+      bytes[n++] = (uint8_t)words[i];
+    if (words[i] & HAL_I2C_STOP)
+    {
+      sim_ssd1306_transaction(&sim.oled, bytes, n);
+      n = 0;
+      transactions++;
+    }
+  }
+
+  // Cada transação: START, endereço e os bytes, 9 bits cada
+  uint64_t bits = (uint64_t)(count + transactions) * 9 + transactions * 2;
+  uint64_t busy_us = sim.i2c_baud ? bits * 1000000u / sim.i2c_baud : 0;
+  uint64_t start = sim.i2c_busy_until > sim.now_us ? sim.i2c_busy_until : sim.now_us;
+  sim.i2c_busy_until = start + busy_us;
+  sim.i2c_transfers++;
+  sim.i2c_bytes += count;
+  if (sim.i2c_log)
+    fprintf(sim.i2c_log, "%.3f,%u,%u,%llu\n", sim.now_us / 1000.0, count, transactions, (unsigned long long)busy_us);
+}
+
+bool hal_i2c_stream_wait(bool until_idle, uint32_t timeout_us)
+{
+  if (sim.i2c_busy_until > sim.now_us)
+    sim_advance_to(sim.i2c_busy_until);
+  return true;
+}
+
+// ---- Serial ----
+
+void hal_serial_init()
+{
+}
+
+void hal_serial_putc(uint8_t c)
+{
+  if (sim.serial_out)
+    fputc(c, sim.serial_out);
+}
+
+int hal_serial_getc()
+{
+  if (sim.serial_in.empty())
+    return -1;
+  int c = (uint8_t)sim.serial_in[0];
+  sim.serial_in.erase(0, 1);
+  return c;
+}
+
+bool hal_serial_connected()
+{
+  return true;
+}
+
+// ---- Núcleos ----
+
+void hal_core1_launch(void (*entry)())
+{
+  sim.core1_entry = entry; // O simulador alterna os núcleos por conta própria
+}
+
+void hal_core1_lockout_victim_init()
+{
+}
+
+static inline void hal_dmb()
+{
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+// ---- Flash ----
+
+void hal_flash_region(const uint8_t **base, uint32_t *sectors)
+{
+  if (sim.flash.empty())
+    sim.flash.assign(SIM_FLASH_SECTORS * 4096, 0xFF);
+  *base = sim.flash.data();
+  *sectors = sim.flash.size() / 4096;
+}
+
+bool hal_flash_erase(uint32_t offset)
+{
+  if (offset % 4096 || offset >= sim.flash.size())
+    return false;
+  memset(&sim.flash[offset], 0xFF, 4096);
+  sim.flash_erases++;
+  return true;
+}
+
+bool hal_flash_program(uint32_t offset, const uint8_t *page)
+{
+  if (offset % 256 || offset >= sim.flash.size())
+    return false;
+  for (int i = 0; i < 256; i++)
+    sim.flash[offset + i] &= page[i]; // NOR: só zera bits
+  sim.flash_programs++;
+  return true;
+}
+
+// ---- Causa da inicialização ----
+
+HalResetReason hal_reset_reason()
+{
+  return sim.reset_reason;
+}
+
+// ---- Contador ----
+
+void hal_cycles_start()
+{
+}
+
+uint32_t hal_cycles()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
+
+uint32_t hal_cycles_hz()
+{
+  return 1000000000u;
+}
@@ -0,0 +1,54 @@
+// Benchmark dos trechos críticos no host: os mesmos casos do firmware de benchmark
+// (benchmark_suite() em U7T_JVPdO.cpp, bench.h), compilados com a HAL do host e
+// medidos em nanossegundos. As transferências ao display são emuladas, então o
+// caso ui_frame inclui o custo do emulador.
+//
+// Compilação (alvo do CMake nesta pasta):
+//   cmake -S sim -B build-sim && cmake --build build-sim
+// Uso, com as opções do Google Benchmark que fazem sentido aqui:
+//   build-sim/simis_bench [--benchmark_filter=texto] [--benchmark_format=console|json]
+//                         [--benchmark_iterations=N]
+
+#include "U7T_JVPdO.cpp"
+
+static void usage(const char *prog)
+{
+  fprintf(stderr, "uso: %s [--benchmark_filter=texto] [--benchmark_format=console|json] [--benchmark_iterations=N]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+  const char *filter = NULL;
+  bool json = false;
+  uint32_t iterations = BENCH_DEFAULT_ITERATIONS;
+
+  for (int i = 1; i < argc; i++)
+  {
+    const char *arg = argv[i];
+    if (strncmp(arg, "--benchmark_filter=", 19) == 0)
+      filter = arg + 19;
+    else if (strcmp(arg, "--benchmark_format=json") == 0)
+      json = true;
+    else if (strcmp(arg, "--benchmark_format=console") == 0)
+      json = false;
+    else if (strncmp(arg, "--benchmark_iterations=", 23) == 0 && atoi(arg + 23) > 0)
+      iterations = (uint32_t)atoi(arg + 23);
+    else
+    {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  // Mesmo estado do firmware antes de o núcleo 1 começar
+  sim.rng = 1;
+  sim.sys_khz = SIM_SYS_CLOCK_KHZ;
+  sim.mic_channel = ADC_MIC;
+  for (int c = 0; c < SIM_ADC_CHANNELS; c++)
+    sim.adc[c] = 2047;
+  sim_set_signal(0.0, 0.0, 0.0);
+  setup();
+
+  benchmark_suite(filter, iterations, json);
+  return 0;
+}
@@ -0,0 +1,344 @@
+// Simulador do SIMIS no Linux: compila o firmware inteiro (U7T_JVPdO.cpp) com a HAL
+// do host (sim/hal_sim.h) e alterna os dois núcleos em um relógio virtual, mais
+// rápido que o tempo real.
+//
+// Compilação (alvo do CMake nesta pasta):
+//   cmake -S sim -B build-sim && cmake --build build-sim
+// Uso:
+//   build-sim/simis_sim [opções]
+//     -t segundos   duração em tempo virtual (padrão 60)
+//     -o pasta      saída (padrão sim_out, precisa existir)
+//     -a arquivo    amostras do microfone: uint16 little-endian de 12 bits, em laço
+//     -g hz:db      tom do gerador (padrão 1000:70)
+//     -n db         ruído branco do gerador (padrão desligado)
+//     -s arquivo    roteiro de eventos
+//     -p ms         salva o display a cada ms de tempo virtual (frame_<ms>.pbm)
+//     -f arquivo    imagem da flash, carregada no início e salva no fim
+//     -r causa      causa da inicialização: power (padrão), pin ou watchdog
+//
+// Roteiro: uma ação por linha, "<segundos> <ação> [argumentos]", '#' comenta:
+//   btn a|b|sel [ms]     aperta um botão (100 ms se omitido)
+//   joy <horz> <vert>    leituras do joystick (0 a 4095; centro 2047)
+//   tone <hz> <db>       troca o sinal para um tom
+//   noise <db>           troca o sinal para ruído branco
+//   silence              sinal parado no meio da escala
+//   bias <contagens>     desloca a polarização do microfone (deriva)
+//   adcdrop              perde uma conversão do ADC (estouro da FIFO)
+//   serial <texto>       bytes recebidos pela serial (ex.: divisor da telemetria)
+//   snap <nome>          salva o display em <nome>.pbm
+//
+// Saídas na pasta: final.pbm, events.csv (LEDs e buzzers), i2c.csv (cada transferência
+// ao display: bytes, transações e tempo de barramento) e serial.bin (telemetria,
+// legível com tools/simis_decode - prefixo < serial.bin).
+
+#include "U7T_JVPdO.cpp"
+
+#include <unistd.h>
+
+static const char *out_dir = "sim_out";
+
+static std::string out_path(const char *name)
+{
+  return std::string(out_dir) + "/" + name;
+}
+
+static void snapshot(const char *name)
+{
+  std::string path = out_path(name) + ".pbm";
+  if (!sim_ssd1306_write_pbm(path.c_str()))
+    perror(path.c_str());
+}
+
+static bool load_samples(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return false;
+  uint8_t b[2];
+  while (fread(b, 1, 2, f) == 2)
+    sim.samples.push_back((uint16_t)((b[0] | (b[1] << 8)) & 0x0FFF));
+  fclose(f);
+  return !sim.samples.empty();
+}
+
+static uint pin_of(const char *name)
+{
+  if (strcmp(name, "a") == 0)
+    return BTNA;
+  if (strcmp(name, "b") == 0)
+    return BTNB;
+  if (strcmp(name, "sel") == 0)
+    return SEL_PIN;
+  return SIM_PINS;
+}
+
+// Lê o roteiro e agenda cada ação; retorna false em erro de sintaxe
+static bool load_script(const char *path)
+{
+  FILE *f = fopen(path, "r");
+  if (!f)
+  {
+    perror(path);
+    return false;
+  }
+
+  char line[256];
+  int line_no = 0;
+  bool ok = true;
+  while (fgets(line, sizeof(line), f))
+  {
+    line_no++;
+    char *hash = strchr(line, '#');
+    if (hash)
+      *hash = '\0';
+    line[strcspn(line, "\r\n")] = '\0';
+
+    double t;
+    char action[16], rest[200] = "";
+    int n = sscanf(line, "%lf %15s %199[^\n]", &t, action, rest);
+    if (n <= 0)
+      continue;
+    uint64_t at = (uint64_t)(t * 1e6);
+    std::string args = rest;
+
+    if (n >= 2 && strcmp(action, "btn") == 0)
+    {
+      char name[8];
+      unsigned ms = 100;
+      uint pin = SIM_PINS;
+      if (sscanf(rest, "%7s %u", name, &ms) >= 1)
+        pin = pin_of(name);
+      if (pin < SIM_PINS)
+      {
+        sim_schedule(at, [pin, ms]() { sim_press(pin, ms); });
+        continue;
+      }
+    }
+    else if (n >= 2 && strcmp(action, "joy") == 0)
+    {
+      unsigned h, v;
+      if (sscanf(rest, "%u %u", &h, &v) == 2)
+      {
+        sim_schedule(at, [h, v]() {
+          sim_set_adc(ADC_HORZ, h > 4095 ? 4095 : h);
+          sim_set_adc(ADC_VERT, v > 4095 ? 4095 : v);
+        });
+        continue;
+      }
+    }
+    else if (n >= 2 && strcmp(action, "tone") == 0)
+    {
+      double hz, db;
+      if (sscanf(rest, "%lf %lf", &hz, &db) == 2)
+      {
+        sim_schedule(at, [hz, db]() { sim_set_signal(hz, db, 0.0); });
+        continue;
+      }
+    }
+    else if (n >= 2 && strcmp(action, "noise") == 0)
+    {
+      double db;
+      if (sscanf(rest, "%lf", &db) == 1)
+      {
+        sim_schedule(at, [db]() { sim_set_signal(0.0, 0.0, db); });
+        continue;
+      }
+    }
+    else if (n >= 2 && strcmp(action, "bias") == 0)
+    {
+      double counts;
+      if (sscanf(rest, "%lf", &counts) == 1)
+      {
+        sim_schedule(at, [counts]() { sim_set_bias(counts); });
+        continue;
+      }
+    }
+    else if (n >= 2 && strcmp(action, "adcdrop") == 0)
+    {
+      sim_schedule(at, []() { sim_mic_drop(); });
+      continue;
+    }
+    else if (n >= 2 && strcmp(action, "silence") == 0)
+    {
+      sim_schedule(at, []() { sim_set_signal(0.0, 0.0, 0.0); });
+      continue;
+    }
+    else if (n == 3 && strcmp(action, "serial") == 0)
+    {
+      sim_schedule(at, [args]() { sim.serial_in += args; });
+      continue;
+    }
+    else if (n == 3 && strcmp(action, "snap") == 0)
+    {
+      sim_schedule(at, [args]() { snapshot(args.c_str()); });
+      continue;
+    }
+
+    fprintf(stderr, "%s:%d: ação inválida\n", path, line_no);
+    ok = false;
+  }
+  fclose(f);
+  return ok;
+}
+
+static void usage(const char *prog)
+{
+  fprintf(stderr, "uso: %s [-t segundos] [-o pasta] [-a amostras | -g hz:db] [-n db] [-s roteiro] [-p ms] [-f flash] [-r power|pin|watchdog]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+  double duration_s = 60.0;
+  double tone_hz = 1000.0, tone_db = 70.0, noise_db = 0.0;
+  const char *samples_path = NULL, *script_path = NULL, *flash_path = NULL;
+  unsigned snap_ms = 0;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "t:o:a:g:n:s:p:f:r:")) != -1)
+  {
+    switch (opt)
+    {
+    case 't':
+      duration_s = atof(optarg);
+      break;
+    case 'o':
+      out_dir = optarg;
+      break;
+    case 'a':
+      samples_path = optarg;
+      break;
+    case 'g':
+      if (sscanf(optarg, "%lf:%lf", &tone_hz, &tone_db) != 2)
+      {
+        usage(argv[0]);
+        return 2;
+      }
+      break;
+    case 'n':
+      noise_db = atof(optarg);
+      break;
+    case 's':
+      script_path = optarg;
+      break;
+    case 'p':
+      snap_ms = atoi(optarg);
+      break;
+    case 'f':
+      flash_path = optarg;
+      break;
+    case 'r':
+      if (strcmp(optarg, "power") == 0)
+        sim.reset_reason = HAL_RESET_POWER;
+      else if (strcmp(optarg, "pin") == 0)
+        sim.reset_reason = HAL_RESET_PIN;
+      else if (strcmp(optarg, "watchdog") == 0)
+        sim.reset_reason = HAL_RESET_WATCHDOG;
+      else
+      {
+        usage(argv[0]);
+        return 2;
+      }
+      break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  if (samples_path && !load_samples(samples_path))
+  {
+    fprintf(stderr, "%s: sem amostras\n", samples_path);
+    return 1;
+  }
+  if (flash_path)
+  {
+    sim.flash.assign(SIM_FLASH_SECTORS * 4096, 0xFF);
+    FILE *f = fopen(flash_path, "rb");
+    if (f)
+    {
+      size_t n = fread(sim.flash.data(), 1, sim.flash.size(), f);
+      (void)n;
+      fclose(f);
+    }
+  }
+
+  sim.events_log = fopen(out_path("events.csv").c_str(), "w");
+  sim.i2c_log = fopen(out_path("i2c.csv").c_str(), "w");
+  sim.serial_out = fopen(out_path("serial.bin").c_str(), "wb");
+  if (!sim.events_log || !sim.i2c_log || !sim.serial_out)
+  {
+    perror(out_dir);
+    return 1;
+  }
+  fprintf(sim.events_log, "time_ms,kind,pin,value\n");
+  fprintf(sim.i2c_log, "time_ms,bytes,transactions,bus_us\n");
+
+  sim.rng = 1;
+  sim.sys_khz = SIM_SYS_CLOCK_KHZ;
+  sim.mic_channel = ADC_MIC;
+  for (int i = 0; i < SIM_ADC_CHANNELS; i++)
+    sim.adc[i] = 2047;
+  sim_set_signal(tone_hz, tone_db, noise_db);
+
+  uint64_t end_us = (uint64_t)(duration_s * 1e6);
+  if (script_path && !load_script(script_path))
+    return 1;
+  if (snap_ms)
+    for (uint64_t t = snap_ms * 1000ull; t <= end_us; t += snap_ms * 1000ull)
+      sim_schedule(t, [t]() {
+        char name[32];
+        snprintf(name, sizeof(name), "frame_%07llu", (unsigned long long)(t / 1000));
+        snapshot(name);
+      });
+
+  struct timespec wall0, wall1;
+  clock_gettime(CLOCK_MONOTONIC, &wall0);
+
+  // Mesma sequência de main(): o núcleo 1 começa depois de setup() e os dois
+  // alternam pelo relógio virtual, cada um no próprio período
+  setup();
+  acquisition_init();
+  uint64_t core0_next = sim.now_us, core1_next = sim.now_us;
+  while (sim.now_us < end_us)
+  {
+    if (core1_next <= core0_next)
+    {
+      sim_advance_to(core1_next);
+      acquisition_step();
+      core1_next = sim.now_us + acquisition_sleep_us();
+    }
+    else
+    {
+      sim_advance_to(core0_next);
+      core0_next = sim.now_us + loop(); // O laço principal dorme até a próxima tarefa
+    }
+  }
+  sim_advance_to(end_us);
+
+  clock_gettime(CLOCK_MONOTONIC, &wall1);
+  double wall_s = (wall1.tv_sec - wall0.tv_sec) + (wall1.tv_nsec - wall0.tv_nsec) * 1e-9;
+
+  snapshot("final");
+  fclose(sim.events_log);
+  fclose(sim.i2c_log);
+  fclose(sim.serial_out);
+  if (flash_path)
+  {
+    FILE *f = fopen(flash_path, "wb");
+    if (f)
+    {
+      fwrite(sim.flash.data(), 1, sim.flash.size(), f);
+      fclose(f);
+    }
+  }
+
+  MicCaptureStats cap = mic_capture_get_stats();
+  fprintf(stderr, "tempo virtual %.1f s em %.2f s (%.0fx)\n", sim.now_us * 1e-6, wall_s, wall_s > 0 ? sim.now_us * 1e-6 / wall_s : 0.0);
+  fprintf(stderr, "blocos=%u amostras=%llu perdidas=%llu nível=%.1f dB Leq=%.1f dB dose NIOSH=%.2f%%\n", meas.blocks,
+          (unsigned long long)cap.processed, (unsigned long long)cap.lost, meas.intensity, meas.stats.leq_cdb * 0.01f,
+          meas.dose.dose[DOSE_NIOSH] * 100.0f);
+  fprintf(stderr, "display: %u transferências, %llu bytes; alarmes: exposição=%d volume=%d; flash: %u apagamentos, %u páginas\n",
+          sim.i2c_transfers, (unsigned long long)sim.i2c_bytes, alarmCountSafe, alarmCountMaxVolume, sim.flash_erases,
+          sim.flash_programs);
+  return 0;
+}
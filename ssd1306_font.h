@@ -1,51 +1,180 @@
-/**
- * Copyright (c) 2022 Raspberry Pi (Trading) Ltd.
- *
- * SPDX-License-Identifier: BSD-3-Clause
- */
+// Generated by tools/gen_font.py - edit the drawings there, not this file.
+//
+// Printable ASCII plus the degree sign (Latin-1 0xB0), 5x7 with one row for
+// descenders. Glyphs are vertical bytes (bit 0 on top) so they copy straight
+// into a frame buffer page. Every table is const and stays in flash.
 
-// Vertical bitmaps, A-Z, 0-9. Each is 8 pixels high and wide
-// These are defined vertically to make them quick to copy to FB
+#define FONT_GLYPHS 96
+#define FONT_MONO_WIDTH 8
+#define FONT_HEIGHT 8
 
-static uint8_t font[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
-    0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, //A
-    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, //B
-    0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00, //C
-    0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00, //D
-    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00, //E
-    0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00, //F
-    0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00, //G
-    0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00, //H
-    0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, //I
-    0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00, //J
-    0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00, //K
-    0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, //L
-    0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00, //M
-    0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00, //N
-    0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00, //O
-    0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, //P
-    0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00, //Q
-    0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00, //R
-    0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, //S
-    0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00, //T
-    0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00, //U
-    0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00, //V
-    0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00, //W
-    0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00, //X
-    0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00, //Y
-    0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00, //Z
-    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, //0
-    0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, //1
-    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, //2
-    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, //3
-    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, //4
-    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, //5
-    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, //6
-    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, //7
-    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, //8
-    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, //9
-    0x00, 0x00, 0x00, 0x24, 0x24, 0x00, 0x00, 0x00, //:
-    0x00, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0x00, //.
-    };
-    
\ No newline at end of file
+// Character code -> glyph; undefined codes map to glyph 0 (space)
+static const uint8_t font_index[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,
+     16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,
+     32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,
+     48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,
+     64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,
+     80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,  93,  94,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+     95,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+};
+
+// Monospaced: 8 columns per glyph, glyph in columns 1-5
+static const uint8_t font_mono[FONT_GLYPHS][FONT_MONO_WIDTH] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // space
+    {0x00, 0x00, 0x00, 0x5f, 0x00, 0x00, 0x00, 0x00}, // !
+    {0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00}, // "
+    {0x00, 0x14, 0x7f, 0x14, 0x7f, 0x14, 0x00, 0x00}, // #
+    {0x00, 0x24, 0x2a, 0x7f, 0x2a, 0x12, 0x00, 0x00}, // $
+    {0x00, 0x23, 0x13, 0x08, 0x64, 0x62, 0x00, 0x00}, // %
+    {0x00, 0x36, 0x49, 0x55, 0x22, 0x50, 0x00, 0x00}, // &
+    {0x00, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00}, // '
+    {0x00, 0x00, 0x1c, 0x22, 0x41, 0x00, 0x00, 0x00}, // (
+    {0x00, 0x00, 0x41, 0x22, 0x1c, 0x00, 0x00, 0x00}, // )
+    {0x00, 0x14, 0x08, 0x3e, 0x08, 0x14, 0x00, 0x00}, // *
+    {0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00}, // +
+    {0x00, 0x00, 0xa0, 0x60, 0x00, 0x00, 0x00, 0x00}, // ,
+    {0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00}, // -
+    {0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00}, // .
+    {0x00, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00, 0x00}, // /
+    {0x00, 0x3e, 0x51, 0x49, 0x45, 0x3e, 0x00, 0x00}, // 0
+    {0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00}, // 1
+    {0x00, 0x42, 0x61, 0x51, 0x49, 0x46, 0x00, 0x00}, // 2
+    {0x00, 0x21, 0x41, 0x45, 0x4b, 0x31, 0x00, 0x00}, // 3
+    {0x00, 0x18, 0x14, 0x12, 0x7f, 0x10, 0x00, 0x00}, // 4
+    {0x00, 0x27, 0x45, 0x45, 0x45, 0x39, 0x00, 0x00}, // 5
+    {0x00, 0x3c, 0x4a, 0x49, 0x49, 0x30, 0x00, 0x00}, // 6
+    {0x00, 0x01, 0x71, 0x09, 0x05, 0x03, 0x00, 0x00}, // 7
+    {0x00, 0x36, 0x49, 0x49, 0x49, 0x36, 0x00, 0x00}, // 8
+    {0x00, 0x06, 0x49, 0x49, 0x29, 0x1e, 0x00, 0x00}, // 9
+    {0x00, 0x00, 0x36, 0x36, 0x00, 0x00, 0x00, 0x00}, // :
+    {0x00, 0x00, 0x56, 0x36, 0x00, 0x00, 0x00, 0x00}, // ;
+    {0x00, 0x08, 0x14, 0x22, 0x41, 0x00, 0x00, 0x00}, // <
+    {0x00, 0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x00}, // =
+    {0x00, 0x00, 0x41, 0x22, 0x14, 0x08, 0x00, 0x00}, // >
+    {0x00, 0x02, 0x01, 0x51, 0x09, 0x06, 0x00, 0x00}, // ?
+    {0x00, 0x32, 0x49, 0x79, 0x41, 0x3e, 0x00, 0x00}, // @
+    {0x00, 0x7e, 0x09, 0x09, 0x09, 0x7e, 0x00, 0x00}, // A
+    {0x00, 0x7f, 0x49, 0x49, 0x49, 0x36, 0x00, 0x00}, // B
+    {0x00, 0x3e, 0x41, 0x41, 0x41, 0x22, 0x00, 0x00}, // C
+    {0x00, 0x7f, 0x41, 0x41, 0x22, 0x1c, 0x00, 0x00}, // D
+    {0x00, 0x7f, 0x49, 0x49, 0x49, 0x41, 0x00, 0x00}, // E
+    {0x00, 0x7f, 0x09, 0x09, 0x09, 0x01, 0x00, 0x00}, // F
+    {0x00, 0x3e, 0x41, 0x49, 0x49, 0x7a, 0x00, 0x00}, // G
+    {0x00, 0x7f, 0x08, 0x08, 0x08, 0x7f, 0x00, 0x00}, // H
+    {0x00, 0x00, 0x41, 0x7f, 0x41, 0x00, 0x00, 0x00}, // I
+    {0x00, 0x20, 0x40, 0x41, 0x3f, 0x01, 0x00, 0x00}, // J
+    {0x00, 0x7f, 0x08, 0x14, 0x22, 0x41, 0x00, 0x00}, // K
+    {0x00, 0x7f, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00}, // L
+    {0x00, 0x7f, 0x02, 0x0c, 0x02, 0x7f, 0x00, 0x00}, // M
+    {0x00, 0x7f, 0x04, 0x08, 0x10, 0x7f, 0x00, 0x00}, // N
+    {0x00, 0x3e, 0x41, 0x41, 0x41, 0x3e, 0x00, 0x00}, // O
+    {0x00, 0x7f, 0x09, 0x09, 0x09, 0x06, 0x00, 0x00}, // P
+    {0x00, 0x3e, 0x41, 0x51, 0x21, 0x5e, 0x00, 0x00}, // Q
+    {0x00, 0x7f, 0x09, 0x19, 0x29, 0x46, 0x00, 0x00}, // R
+    {0x00, 0x46, 0x49, 0x49, 0x49, 0x31, 0x00, 0x00}, // S
+    {0x00, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x00, 0x00}, // T
+    {0x00, 0x3f, 0x40, 0x40, 0x40, 0x3f, 0x00, 0x00}, // U
+    {0x00, 0x1f, 0x20, 0x40, 0x20, 0x1f, 0x00, 0x00}, // V
+    {0x00, 0x3f, 0x40, 0x38, 0x40, 0x3f, 0x00, 0x00}, // W
+    {0x00, 0x63, 0x14, 0x08, 0x14, 0x63, 0x00, 0x00}, // X
+    {0x00, 0x03, 0x04, 0x78, 0x04, 0x03, 0x00, 0x00}, // Y
+    {0x00, 0x61, 0x51, 0x49, 0x45, 0x43, 0x00, 0x00}, // Z
+    {0x00, 0x00, 0x7f, 0x41, 0x41, 0x00, 0x00, 0x00}, // [
+    {0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x00}, // 0x5C
+    {0x00, 0x00, 0x41, 0x41, 0x7f, 0x00, 0x00, 0x00}, // ]
+    {0x00, 0x04, 0x02, 0x01, 0x02, 0x04, 0x00, 0x00}, // ^
+    {0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00}, // _
+    {0x00, 0x00, 0x01, 0x02, 0x04, 0x00, 0x00, 0x00}, // `
+    {0x00, 0x20, 0x54, 0x54, 0x54, 0x78, 0x00, 0x00}, // a
+    {0x00, 0x7f, 0x48, 0x44, 0x44, 0x38, 0x00, 0x00}, // b
+    {0x00, 0x38, 0x44, 0x44, 0x44, 0x20, 0x00, 0x00}, // c
+    {0x00, 0x38, 0x44, 0x44, 0x48, 0x7f, 0x00, 0x00}, // d
+    {0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00}, // e
+    {0x00, 0x08, 0x7e, 0x09, 0x01, 0x02, 0x00, 0x00}, // f
+    {0x00, 0x18, 0xa4, 0xa4, 0xa4, 0x7c, 0x00, 0x00}, // g
+    {0x00, 0x7f, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00}, // h
+    {0x00, 0x00, 0x44, 0x7d, 0x40, 0x00, 0x00, 0x00}, // i
+    {0x00, 0x40, 0x80, 0x84, 0x7d, 0x00, 0x00, 0x00}, // j
+    {0x00, 0x7f, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00}, // k
+    {0x00, 0x00, 0x41, 0x7f, 0x40, 0x00, 0x00, 0x00}, // l
+    {0x00, 0x7c, 0x04, 0x18, 0x04, 0x78, 0x00, 0x00}, // m
+    {0x00, 0x7c, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00}, // n
+    {0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00}, // o
+    {0x00, 0xfc, 0x24, 0x24, 0x24, 0x18, 0x00, 0x00}, // p
+    {0x00, 0x18, 0x24, 0x24, 0x24, 0xfc, 0x00, 0x00}, // q
+    {0x00, 0x7c, 0x08, 0x04, 0x04, 0x08, 0x00, 0x00}, // r
+    {0x00, 0x48, 0x54, 0x54, 0x54, 0x24, 0x00, 0x00}, // s
+    {0x00, 0x04, 0x3f, 0x44, 0x40, 0x20, 0x00, 0x00}, // t
+    {0x00, 0x3c, 0x40, 0x40, 0x20, 0x7c, 0x00, 0x00}, // u
+    {0x00, 0x1c, 0x20, 0x40, 0x20, 0x1c, 0x00, 0x00}, // v
+    {0x00, 0x3c, 0x40, 0x30, 0x40, 0x3c, 0x00, 0x00}, // w
+    {0x00, 0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x00}, // x
+    {0x00, 0x1c, 0xa0, 0xa0, 0xa0, 0x7c, 0x00, 0x00}, // y
+    {0x00, 0x44, 0x64, 0x54, 0x4c, 0x44, 0x00, 0x00}, // z
+    {0x00, 0x00, 0x08, 0x36, 0x41, 0x00, 0x00, 0x00}, // {
+    {0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00}, // |
+    {0x00, 0x00, 0x41, 0x36, 0x08, 0x00, 0x00, 0x00}, // }
+    {0x00, 0x08, 0x04, 0x08, 0x10, 0x08, 0x00, 0x00}, // ~
+    {0x00, 0x06, 0x09, 0x09, 0x06, 0x00, 0x00, 0x00}, // 0xB0
+};
+
+// Proportional: blank columns trimmed, one column of spacing added when drawing
+typedef struct {
+    uint16_t offset; // first column in font_prop_data
+    uint8_t width;
+} FontPropGlyph;
+
+static const FontPropGlyph font_prop[FONT_GLYPHS] = {
+    {0, 3}, {3, 1}, {4, 3}, {7, 5}, {12, 5}, {17, 5}, {22, 5}, {27, 2},
+    {29, 3}, {32, 3}, {35, 5}, {40, 5}, {45, 2}, {47, 5}, {52, 2}, {54, 5},
+    {59, 5}, {64, 3}, {67, 5}, {72, 5}, {77, 5}, {82, 5}, {87, 5}, {92, 5},
+    {97, 5}, {102, 5}, {107, 2}, {109, 2}, {111, 4}, {115, 5}, {120, 4}, {124, 5},
+    {129, 5}, {134, 5}, {139, 5}, {144, 5}, {149, 5}, {154, 5}, {159, 5}, {164, 5},
+    {169, 5}, {174, 3}, {177, 5}, {182, 5}, {187, 5}, {192, 5}, {197, 5}, {202, 5},
+    {207, 5}, {212, 5}, {217, 5}, {222, 5}, {227, 5}, {232, 5}, {237, 5}, {242, 5},
+    {247, 5}, {252, 5}, {257, 5}, {262, 3}, {265, 5}, {270, 3}, {273, 5}, {278, 5},
+    {283, 3}, {286, 5}, {291, 5}, {296, 5}, {301, 5}, {306, 5}, {311, 5}, {316, 5},
+    {321, 5}, {326, 3}, {329, 4}, {333, 4}, {337, 3}, {340, 5}, {345, 5}, {350, 5},
+    {355, 5}, {360, 5}, {365, 5}, {370, 5}, {375, 5}, {380, 5}, {385, 5}, {390, 5},
+    {395, 5}, {400, 5}, {405, 5}, {410, 3}, {413, 1}, {414, 3}, {417, 5}, {422, 4},
+};
+
+static const uint8_t font_prop_data[426] = {
+    0x00, 0x00, 0x00, 0x5f, 0x03, 0x00, 0x03, 0x14, 0x7f, 0x14, 0x7f, 0x14, 0x24, 0x2a, 0x7f, 0x2a,
+    0x12, 0x23, 0x13, 0x08, 0x64, 0x62, 0x36, 0x49, 0x55, 0x22, 0x50, 0x04, 0x03, 0x1c, 0x22, 0x41,
+    0x41, 0x22, 0x1c, 0x14, 0x08, 0x3e, 0x08, 0x14, 0x08, 0x08, 0x3e, 0x08, 0x08, 0xa0, 0x60, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0x60, 0x60, 0x20, 0x10, 0x08, 0x04, 0x02, 0x3e, 0x51, 0x49, 0x45, 0x3e,
+    0x42, 0x7f, 0x40, 0x42, 0x61, 0x51, 0x49, 0x46, 0x21, 0x41, 0x45, 0x4b, 0x31, 0x18, 0x14, 0x12,
+    0x7f, 0x10, 0x27, 0x45, 0x45, 0x45, 0x39, 0x3c, 0x4a, 0x49, 0x49, 0x30, 0x01, 0x71, 0x09, 0x05,
+    0x03, 0x36, 0x49, 0x49, 0x49, 0x36, 0x06, 0x49, 0x49, 0x29, 0x1e, 0x36, 0x36, 0x56, 0x36, 0x08,
+    0x14, 0x22, 0x41, 0x14, 0x14, 0x14, 0x14, 0x14, 0x41, 0x22, 0x14, 0x08, 0x02, 0x01, 0x51, 0x09,
+    0x06, 0x32, 0x49, 0x79, 0x41, 0x3e, 0x7e, 0x09, 0x09, 0x09, 0x7e, 0x7f, 0x49, 0x49, 0x49, 0x36,
+    0x3e, 0x41, 0x41, 0x41, 0x22, 0x7f, 0x41, 0x41, 0x22, 0x1c, 0x7f, 0x49, 0x49, 0x49, 0x41, 0x7f,
+    0x09, 0x09, 0x09, 0x01, 0x3e, 0x41, 0x49, 0x49, 0x7a, 0x7f, 0x08, 0x08, 0x08, 0x7f, 0x41, 0x7f,
+    0x41, 0x20, 0x40, 0x41, 0x3f, 0x01, 0x7f, 0x08, 0x14, 0x22, 0x41, 0x7f, 0x40, 0x40, 0x40, 0x40,
+    0x7f, 0x02, 0x0c, 0x02, 0x7f, 0x7f, 0x04, 0x08, 0x10, 0x7f, 0x3e, 0x41, 0x41, 0x41, 0x3e, 0x7f,
+    0x09, 0x09, 0x09, 0x06, 0x3e, 0x41, 0x51, 0x21, 0x5e, 0x7f, 0x09, 0x19, 0x29, 0x46, 0x46, 0x49,
+    0x49, 0x49, 0x31, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x3f, 0x40, 0x40, 0x40, 0x3f, 0x1f, 0x20, 0x40,
+    0x20, 0x1f, 0x3f, 0x40, 0x38, 0x40, 0x3f, 0x63, 0x14, 0x08, 0x14, 0x63, 0x03, 0x04, 0x78, 0x04,
+    0x03, 0x61, 0x51, 0x49, 0x45, 0x43, 0x7f, 0x41, 0x41, 0x02, 0x04, 0x08, 0x10, 0x20, 0x41, 0x41,
+    0x7f, 0x04, 0x02, 0x01, 0x02, 0x04, 0x40, 0x40, 0x40, 0x40, 0x40, 0x01, 0x02, 0x04, 0x20, 0x54,
+    0x54, 0x54, 0x78, 0x7f, 0x48, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x20, 0x38, 0x44, 0x44,
+    0x48, 0x7f, 0x38, 0x54, 0x54, 0x54, 0x18, 0x08, 0x7e, 0x09, 0x01, 0x02, 0x18, 0xa4, 0xa4, 0xa4,
+    0x7c, 0x7f, 0x08, 0x04, 0x04, 0x78, 0x44, 0x7d, 0x40, 0x40, 0x80, 0x84, 0x7d, 0x7f, 0x10, 0x28,
+    0x44, 0x41, 0x7f, 0x40, 0x7c, 0x04, 0x18, 0x04, 0x78, 0x7c, 0x08, 0x04, 0x04, 0x78, 0x38, 0x44,
+    0x44, 0x44, 0x38, 0xfc, 0x24, 0x24, 0x24, 0x18, 0x18, 0x24, 0x24, 0x24, 0xfc, 0x7c, 0x08, 0x04,
+    0x04, 0x08, 0x48, 0x54, 0x54, 0x54, 0x24, 0x04, 0x3f, 0x44, 0x40, 0x20, 0x3c, 0x40, 0x40, 0x20,
+    0x7c, 0x1c, 0x20, 0x40, 0x20, 0x1c, 0x3c, 0x40, 0x30, 0x40, 0x3c, 0x44, 0x28, 0x10, 0x28, 0x44,
+    0x1c, 0xa0, 0xa0, 0xa0, 0x7c, 0x44, 0x64, 0x54, 0x4c, 0x44, 0x08, 0x36, 0x41, 0x7f, 0x41, 0x36,
+    0x08, 0x08, 0x04, 0x08, 0x10, 0x08, 0x06, 0x09, 0x09, 0x06,
+};
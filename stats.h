@@ -0,0 +1,111 @@
+// Estatísticas incrementais de nível sonoro: Leq, Lmax, Lmin e níveis percentis.
+//
+// O Leq é a média de energia (não a média dos dB): soma a energia e o número de
+// amostras de cada bloco e converte uma única vez com level_db.h (incluído antes).
+// Os percentis vêm de um histograma fixo de STATS_HIST_BINS faixas de 0.1 dB, com um
+// bloco de medição por contagem; LN é o nível excedido em N% do tempo (L10, L50, L90).
+// A memória não cresce com a duração da janela (de um reset ao seguinte), e cada
+// janela independente é só mais um StatsState.
+
+#include <stdint.h>
+#include <string.h>
+
+#define STATS_HIST_BIN_CDB 10 // 0.1 dB por faixa
+#define STATS_HIST_BINS 1400  // 0 a 140 dB
+
+typedef struct
+{
+  uint64_t energy;  // Soma da energia dos blocos (mesma escala de level_cdb_from_energy)
+  uint64_t samples; // Amostras somadas em energy
+  int32_t max_cdb;
+  int32_t min_cdb;
+  uint32_t blocks;  // Blocos no histograma
+  uint32_t hist[STATS_HIST_BINS];
+} StatsState;
+
+typedef struct
+{
+  int32_t leq_cdb;
+  int32_t lmax_cdb;
+  int32_t lmin_cdb;
+  int32_t l10_cdb;
+  int32_t l50_cdb;
+  int32_t l90_cdb;
+  uint32_t blocks;
+} StatsSummary;
+
+void stats_reset(StatsState *s)
+{
+  memset(s, 0, sizeof(*s));
+  s->max_cdb = INT32_MIN;
+  s->min_cdb = INT32_MAX;
+}
+
+// Acrescenta um bloco de medição: nível já convertido e a energia que o gerou
+void stats_add(StatsState *s, int32_t level_cdb, uint64_t energy, uint32_t samples)
+{
+  // Perto do estouro as duas somas são divididas por 2; o Leq (a razão) se mantém
+  if (s->energy > UINT64_MAX - energy)
+  {
+    s->energy >>= 1;
+    s->samples >>= 1;
+    energy >>= 1;
+    samples >>= 1;
+  }
+  s->energy += energy;
+  s->samples += samples;
+
+  if (level_cdb > s->max_cdb)
+    s->max_cdb = level_cdb;
+  if (level_cdb < s->min_cdb)
+    s->min_cdb = level_cdb;
+
+  int32_t bin = level_cdb / STATS_HIST_BIN_CDB;
+  if (bin < 0)
+    bin = 0;
+  if (bin >= STATS_HIST_BINS)
+    bin = STATS_HIST_BINS - 1;
+  s->hist[bin]++;
+  s->blocks++;
+}
+
+// Resumo da janela; offset_cdb é a calibração passada a level_cdb_from_energy
+void stats_summary(const StatsState *s, int32_t offset_cdb, StatsSummary *out)
+{
+  memset(out, 0, sizeof(*out));
+  out->blocks = s->blocks;
+  if (s->blocks == 0)
+    return;
+
+  out->leq_cdb = level_cdb_from_energy(s->energy, s->samples, offset_cdb);
+  out->lmax_cdb = s->max_cdb;
+  out->lmin_cdb = s->min_cdb;
+
+  // Percorre do nível mais alto para o mais baixo: LN é a primeira faixa em que a
+  // contagem acumulada alcança N% dos blocos
+  const uint32_t n10 = (uint32_t)(((uint64_t)s->blocks * 10 + 99) / 100);
+  const uint32_t n50 = (uint32_t)(((uint64_t)s->blocks * 50 + 99) / 100);
+  const uint32_t n90 = (uint32_t)(((uint64_t)s->blocks * 90 + 99) / 100);
+  uint32_t acc = 0;
+  bool got10 = false, got50 = false;
+  for (int32_t bin = STATS_HIST_BINS - 1; bin >= 0; bin--)
+  {
+    acc += s->hist[bin];
+    int32_t level = bin * STATS_HIST_BIN_CDB;
+    if (!got10 && acc >= n10)
+    {
+      out->l10_cdb = level;
+      got10 = true;
+    }
+    if (!got50 && acc >= n50)
+    {
+      out->l50_cdb = level;
+      got50 = true;
+    }
+    if (acc >= n90)
+    {
+      out->l90_cdb = level;
+      break;
+    }
+  }
+}
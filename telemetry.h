@@ -0,0 +1,190 @@
+// Protocolo binário de telemetria pela USB (CDC).
+//
+// Cada quadro é [tipo][seq][carga][CRC-16 LE], codificado em COBS e terminado por
+// 0x00. Como o COBS não deixa zeros dentro do quadro, o receptor se ressincroniza
+// no próximo 0x00 depois de qualquer byte perdido; o CRC-16/CCITT-FALSE (sobre
+// tipo, seq e carga) descarta quadros corrompidos. seq cresce a cada quadro e
+// mostra quadros perdidos. Os campos são little-endian, sem preenchimento.
+//
+// Este arquivo não depende do SDK: o firmware e o decodificador do host
+// (tools/simis_decode.cpp) usam as mesmas estruturas e funções.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define TELEMETRY_MAX_PAYLOAD 32
+#define TELEMETRY_MAX_RAW (2 + TELEMETRY_MAX_PAYLOAD + 2)
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_RAW + TELEMETRY_MAX_RAW / 254 + 2) // COBS + 0x00
+
+typedef enum
+{
+  TEL_LEVEL = 1, // Um bloco de medição
+  TEL_ALARM,     // Mudança de estado do alarme
+  TEL_TIMING,    // Tempos das etapas
+  TEL_STATUS,    // Contadores da captura e do display
+  TEL_HISTORY,   // Um registro do histórico em flash (pedido pelo host)
+} TelemetryType;
+
+typedef struct __attribute__((packed))
+{
+  uint32_t block;         // Índice do bloco de medição (núcleo 1)
+  int16_t level_cdb;      // Nível do bloco
+  int16_t recent_leq_cdb; // Leq das últimas 10 leituras
+  uint16_t dose_niosh;    // Centésimos de %
+  uint16_t dose_osha;
+  uint8_t weighting;      // Weighting
+  uint8_t alarm_state;    // AlarmState
+} TelLevel;
+
+typedef struct __attribute__((packed))
+{
+  uint32_t block;
+  uint8_t state;      // Novo AlarmState
+  uint8_t previous;   // Estado anterior
+  char reason[16];    // Motivo (terminado em '\0')
+} TelAlarm;
+
+typedef struct __attribute__((packed))
+{
+  uint32_t block;
+  uint16_t capture_us; // Maior tempo de mic_capture_service() desde o último quadro
+  uint16_t bands_us;   // Maior tempo de bands_service()
+  uint16_t level_us;   // Maior tempo de nível, dose e estatísticas de um bloco
+  uint16_t frame_us;   // Duração do último quadro da interface (núcleo 0)
+  uint16_t render_wait_us; // Espera pelo DMA do display no último quadro
+  uint16_t input_misses;   // Prazos perdidos por tarefa do núcleo 0 desde o boot (sched.h)
+  uint16_t frame_misses;
+  uint16_t history_misses;
+} TelTiming;
+
+typedef struct __attribute__((packed))
+{
+  uint32_t block;
+  uint32_t lost;       // Amostras perdidas pela captura
+  uint32_t overruns;
+  uint32_t fifo_overflows;
+  uint32_t oled_bytes; // Bytes enviados ao display no último quadro
+  uint32_t oled_errors;
+  uint16_t mic_baseline_q4; // Polarização estimada do microfone (contagens Q4 do ADC)
+  uint16_t power_mw_x10;    // Consumo estimado desde o quadro anterior (décimos de mW = mWh/h)
+  uint8_t clock_mhz;        // Relógio do sistema
+  uint8_t display;          // PowerDisplay: 0 aceso, 1 reduzido, 2 apagado
+  uint16_t over_range;      // Episódios de saturação do ADC desde o boot
+} TelStatus;
+
+typedef struct __attribute__((packed))
+{
+  uint32_t seq;           // Número do registro no histórico
+  uint32_t minute;        // Minutos desde a inicialização
+  uint16_t boot;          // Inicialização que gravou o registro
+  int16_t leq_cdb;        // Leq do minuto
+  int16_t lmax_cdb;       // Maior nível de bloco do minuto
+  uint16_t dose_niosh;    // Centésimos de %
+  uint16_t dose_osha;
+  uint16_t alarms_safe;   // Alarmes de dose e de volume da jornada
+  uint16_t alarms_volume;
+  uint8_t alarm_state;    // AlarmState no fim do minuto
+  uint8_t weighting;      // Weighting
+  uint16_t shift_minutes; // Tempo de exposição somado na dose
+  uint8_t reset_reason;   // Causa da inicialização (HalResetReason)
+  uint8_t shift;          // Origem da dose (FlashLogShift)
+} TelHistory;
+
+static_assert(sizeof(TelAlarm) <= TELEMETRY_MAX_PAYLOAD, "carga grande demais");
+static_assert(sizeof(TelStatus) <= TELEMETRY_MAX_PAYLOAD, "carga grande demais");
+static_assert(sizeof(TelHistory) <= TELEMETRY_MAX_PAYLOAD, "carga grande demais");
+
+static uint16_t telemetry_crc16(const uint8_t *data, size_t len)
+{
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++)
+  {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int b = 0; b < 8; b++)
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+// Codifica len bytes em COBS e acrescenta o 0x00; retorna o tamanho escrito
+static inline size_t telemetry_cobs_encode(const uint8_t *in, size_t len, uint8_t *out)
+{
+  size_t code_pos = 0, o = 1;
+  uint8_t code = 1;
+  for (size_t i = 0; i < len; i++)
+  {
+    if (in[i] == 0)
+    {
+      out[code_pos] = code;
+      code_pos = o++;
+      code = 1;
+      continue;
+    }
+    out[o++] = in[i];
+    if (++code == 0xFF)
+    {
+      out[code_pos] = code;
+      code_pos = o++;
+      code = 1;
+    }
+  }
+  out[code_pos] = code;
+  out[o++] = 0x00;
+  return o;
+}
+
+// Decodifica um quadro COBS (sem o 0x00 final); retorna o tamanho ou 0 se inválido
+static inline size_t telemetry_cobs_decode(const uint8_t *in, size_t len, uint8_t *out, size_t out_max)
+{
+  size_t i = 0, o = 0;
+  while (i < len)
+  {
+    uint8_t code = in[i++];
+    if (code == 0 || i + code - 1 > len)
+      return 0;
+    for (uint8_t k = 1; k < code; k++)
+    {
+      if (o >= out_max)
+        return 0;
+      out[o++] = in[i++];
+    }
+    if (code != 0xFF && i < len)
+    {
+      if (o >= out_max)
+        return 0;
+      out[o++] = 0;
+    }
+  }
+  return o;
+}
+
+// Monta o quadro completo (COBS + 0x00) em frame; retorna o tamanho
+static inline size_t telemetry_frame(uint8_t type, uint8_t seq, const void *payload, size_t len, uint8_t *frame)
+{
+  uint8_t raw[TELEMETRY_MAX_RAW];
+  if (len > TELEMETRY_MAX_PAYLOAD)
+    return 0;
+  raw[0] = type;
+  raw[1] = seq;
+  memcpy(raw + 2, payload, len);
+  uint16_t crc = telemetry_crc16(raw, len + 2);
+  raw[len + 2] = (uint8_t)crc;
+  raw[len + 3] = (uint8_t)(crc >> 8);
+  return telemetry_cobs_encode(raw, len + 4, frame);
+}
+
+// Valida um quadro decodificado; devolve tipo, seq e a carga (dentro de raw)
+static inline bool telemetry_parse(const uint8_t *raw, size_t len, uint8_t *type, uint8_t *seq, const uint8_t **payload, size_t *payload_len)
+{
+  if (len < 4)
+    return false;
+  uint16_t crc = (uint16_t)(raw[len - 2] | (raw[len - 1] << 8));
+  if (crc != telemetry_crc16(raw, len - 2))
+    return false;
+  *type = raw[0];
+  *seq = raw[1];
+  *payload = raw + 2;
+  *payload_len = len - 4;
+  return true;
+}
@@ -0,0 +1,85 @@
+// Ponderação temporal F, S e I (IEC 61672-1 / IEC 60651) e pico, em ponto fixo.
+//
+// Cada detector é uma média exponencial da energia por amostra (a amostra ponderada
+// ao quadrado), atualizada a cada amostra: ms += (e - ms) * alpha, alpha = 1/(tau fs).
+// Sem FPU e sem multiplicador de 64 bits, alpha é uma soma de potências de 2, então a
+// atualização custa só somas e deslocamentos. Valores para 32 kHz:
+//   F (125 ms): 2^-12 + 2^-17         -> tau = 3971 amostras = 124.1 ms
+//   S (1 s):    2^-15 + 2^-20         -> tau = 31775 amostras = 0.993 s
+//   I (35 ms):  2^-10 - 2^-14 - 2^-16 -> tau = 1111 amostras = 34.7 ms na subida
+//   I, descida: 2^-16 + 2^-18 + 2^-19 -> tau = 47663 amostras = 1.49 s
+// Todos dentro de 3% do nominal. A descida do I é a de um detector de pico: o valor
+// mostrado é o máximo entre a média de 35 ms e o valor anterior decaindo com 1.5 s.
+//
+// O estado guarda TW_FRAC bits além da energia, senão (e - ms) >> 20 zeraria abaixo
+// de 2^20 e o S pararia de descer em níveis baixos. A energia vem em Q16 (contagens
+// Q8 ao quadrado, até 2^38), então o estado cabe com folga em 64 bits com sinal.
+//
+// O pico é o maior |amostra| do bloco; a curva (C, para o LCpeak) é aplicada por quem
+// chama. Depende de level_db.h e de mic_capture.h, incluídos antes.
+
+#include <stdint.h>
+
+#define TW_FRAC 16
+
+static_assert(MIC_SAMPLE_RATE_HZ == 32000, "constantes de tempo calculadas para 32 kHz");
+
+typedef struct
+{
+  int64_t fast;     // Médias exponenciais da energia, com TW_FRAC bits extras
+  int64_t slow;
+  int64_t impulse;  // Média de 35 ms
+  int64_t impulse_hold; // Valor I: máximo com descida de 1.5 s
+  int64_t fast_max; // Maior valor F desde tw_block_reset()
+  uint32_t peak;    // Maior |amostra| desde tw_block_reset()
+} TimeWeighting;
+
+static inline void tw_block_reset(TimeWeighting *t)
+{
+  t->fast_max = 0;
+  t->peak = 0;
+}
+
+static inline void tw_init(TimeWeighting *t)
+{
+  t->fast = t->slow = t->impulse = t->impulse_hold = 0;
+  tw_block_reset(t);
+}
+
+// Uma amostra: energia (Q16) da amostra ponderada
+static inline void tw_run(TimeWeighting *t, uint64_t energy)
+{
+  int64_t x = (int64_t)energy << TW_FRAC;
+  int64_t d = x - t->fast;
+  t->fast += (d >> 12) + (d >> 17);
+  d = x - t->slow;
+  t->slow += (d >> 15) + (d >> 20);
+  d = x - t->impulse;
+  t->impulse += (d >> 10) - (d >> 14) - (d >> 16);
+
+  int64_t h = t->impulse_hold;
+  h -= (h >> 16) + (h >> 18) + (h >> 19);
+  t->impulse_hold = t->impulse > h ? t->impulse : h;
+  if (t->fast > t->fast_max)
+    t->fast_max = t->fast;
+}
+
+// Uma amostra do pico (mesma escala da amostra cuja energia vai a tw_run)
+static inline void tw_peak(TimeWeighting *t, int32_t sample)
+{
+  uint32_t a = sample < 0 ? (uint32_t)-sample : (uint32_t)sample;
+  if (a > t->peak)
+    t->peak = a;
+}
+
+// Nível em centi-dB de um estado dos detectores
+static inline int32_t tw_level_cdb(int64_t state, int32_t offset_cdb)
+{
+  return level_cdb_from_energy((uint64_t)(state >> TW_FRAC), 1, offset_cdb);
+}
+
+// Nível de pico em centi-dB: 20 log10 do pico, na mesma referência do nível eficaz
+static inline int32_t tw_peak_cdb(uint32_t peak, int32_t offset_cdb)
+{
+  return level_cdb_from_energy((uint64_t)peak * peak, 1, offset_cdb);
+}
@@ -0,0 +1,101 @@
+// Teste da máquina de estados do alarme de alarm.h (roda no host).
+//
+// Confere alarm_next() em todos os pares (estado, evento) contra a especificação
+// do cabeçalho, escrita aqui de novo sem olhar a tabela, e um cenário completo:
+// disparo, trava até o reconhecimento, nenhum redisparo com a condição ainda
+// presente e rearme depois que ela acaba. Também confere entradas fora da faixa e
+// o texto de 15 colunas de cada estado.
+//
+// Compilação e uso:
+//   g++ -std=c++17 -O2 -I. tools/alarm_test.cpp -o alarm_test   (na raiz)
+//   ./alarm_test
+// Sai com código 1 se alguma verificação falhar.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "alarm.h"
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+  printf("%-48s %s\n", what, ok ? "ok" : "FALHOU");
+  if (!ok)
+    failures++;
+}
+
+static const char *state_names[ALARM_STATE_COUNT] = {"IDLE", "FIRING", "ACKNOWLEDGED", "REARMED"};
+static const char *event_names[ALARM_EV_COUNT] = {"CLEAR", "TRIGGER", "ACK"};
+
+// Especificação: o estado seguinte de cada par
+static AlarmState expected(AlarmState state, AlarmEvent event)
+{
+  switch (state)
+  {
+  case ALARM_IDLE:
+    return event == ALARM_EV_TRIGGER ? ALARM_FIRING : ALARM_IDLE; // ACK sem alarme é ignorado
+  case ALARM_FIRING:
+    return event == ALARM_EV_ACK ? ALARM_ACKNOWLEDGED : ALARM_FIRING; // Travado até o reconhecimento
+  case ALARM_ACKNOWLEDGED:
+    return event == ALARM_EV_CLEAR ? ALARM_REARMED : ALARM_ACKNOWLEDGED; // Não redispara
+  case ALARM_REARMED:
+    return event == ALARM_EV_TRIGGER ? ALARM_FIRING : ALARM_REARMED;
+  default:
+    return state;
+  }
+}
+
+// Aplica uma sequência de eventos a partir de IDLE
+static AlarmState run(const AlarmEvent *events, size_t count)
+{
+  AlarmState s = ALARM_IDLE;
+  for (size_t i = 0; i < count; i++)
+    s = alarm_next(s, events[i]);
+  return s;
+}
+
+int main()
+{
+  // Todos os pares
+  int pair_failures = 0;
+  for (int s = 0; s < ALARM_STATE_COUNT; s++)
+    for (int e = 0; e < ALARM_EV_COUNT; e++)
+    {
+      AlarmState got = alarm_next((AlarmState)s, (AlarmEvent)e);
+      AlarmState want = expected((AlarmState)s, (AlarmEvent)e);
+      if (got != want)
+      {
+        printf("  %s + %s -> %s (esperado %s)\n", state_names[s], event_names[e], state_names[got], state_names[want]);
+        pair_failures++;
+      }
+    }
+  check(pair_failures == 0, "transicoes de todos os pares");
+
+  // Entradas fora da faixa não mudam o estado
+  check(alarm_next(ALARM_FIRING, ALARM_EV_COUNT) == ALARM_FIRING, "evento invalido");
+  check(alarm_next(ALARM_STATE_COUNT, ALARM_EV_TRIGGER) == ALARM_STATE_COUNT, "estado invalido");
+
+  // Cenário: dispara, a condição some sem reconhecimento, reconhece com ela de volta
+  const AlarmEvent latched[] = {ALARM_EV_CLEAR, ALARM_EV_TRIGGER, ALARM_EV_CLEAR, ALARM_EV_CLEAR};
+  check(run(latched, 4) == ALARM_FIRING, "disparo travado sem reconhecimento");
+  const AlarmEvent held[] = {ALARM_EV_TRIGGER, ALARM_EV_ACK, ALARM_EV_TRIGGER, ALARM_EV_TRIGGER};
+  check(run(held, 4) == ALARM_ACKNOWLEDGED, "sem redisparo com a condicao presente");
+  const AlarmEvent rearm[] = {ALARM_EV_TRIGGER, ALARM_EV_ACK, ALARM_EV_TRIGGER, ALARM_EV_CLEAR};
+  check(run(rearm, 4) == ALARM_REARMED, "rearme quando a condicao acaba");
+  const AlarmEvent again[] = {ALARM_EV_TRIGGER, ALARM_EV_ACK, ALARM_EV_CLEAR, ALARM_EV_ACK, ALARM_EV_TRIGGER};
+  check(run(again, 5) == ALARM_FIRING, "novo disparo depois do rearme");
+
+  // Texto do display: 15 colunas e diferente para cada estado
+  bool text_ok = true;
+  for (int s = 0; s < ALARM_STATE_COUNT; s++)
+  {
+    text_ok &= strlen(alarm_state_text((AlarmState)s)) == 15;
+    for (int t = 0; t < s; t++)
+      text_ok &= strcmp(alarm_state_text((AlarmState)s), alarm_state_text((AlarmState)t)) != 0;
+  }
+  check(text_ok, "texto de cada estado");
+
+  printf(failures ? "FALHOU\n" : "OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,246 @@
+// Simulador de imagem de flash para o registro de flash_log.h (roda no host).
+//
+// Emula a flash NOR do RP2040: apagar põe o setor em 0xFF e gravar só pode levar
+// bits de 1 para 0. Cortes de energia são simulados interrompendo uma gravação ou
+// um apagamento no meio (só parte dos bytes muda) e reinicializando o registro a
+// partir da imagem. Ao final verifica que:
+//   - todo registro gravado sem corte continua legível, em ordem e sem repetição;
+//   - a numeração continua depois de cada reinicialização, sem repetir na flash;
+//   - os setores foram apagados de forma uniforme (nivelamento de desgaste);
+//   - com os setores apagados com antecedência a cada inicialização
+//     (flash_log_prepare, que também pode ser cortado), nenhum apagamento acontece
+//     durante a gravação até o anel passar deles.
+//
+// Compilação e uso:
+//   g++ -std=c++17 -O2 -I. tools/flash_log_sim.cpp -o flash_log_sim   (na raiz)
+//   ./flash_log_sim [setores] [minutos] [semente] [adiantados]
+// Sai com código 1 se alguma verificação falhar.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "flash_log.h"
+
+static std::vector<uint8_t> image;
+static std::vector<uint32_t> erase_count;
+static uint32_t erases = 0; // Apagamentos completos
+static uint32_t rng_state = 1;
+static int cut_in = -1; // Operações até o próximo corte de energia (-1 = nunca)
+static bool power_lost = false;
+
+static uint32_t rng()
+{
+  rng_state = rng_state * 1664525u + 1013904223u;
+  return rng_state >> 8;
+}
+
+// Decide se esta operação é interrompida; depois do corte nada mais é escrito
+static bool cut_now()
+{
+  if (power_lost)
+    return true;
+  if (cut_in > 0)
+    cut_in--;
+  if (cut_in == 0)
+  {
+    power_lost = true;
+    return true;
+  }
+  return false;
+}
+
+static bool sim_erase(uint32_t offset)
+{
+  if (offset % FLASH_LOG_SECTOR_SIZE || offset >= image.size())
+    return false;
+  if (power_lost)
+    return false;
+  bool cut = cut_now();
+  uint32_t len = cut ? rng() % FLASH_LOG_SECTOR_SIZE : FLASH_LOG_SECTOR_SIZE;
+  for (uint32_t i = 0; i < len; i++)
+    image[offset + i] = 0xFF;
+  erase_count[offset / FLASH_LOG_SECTOR_SIZE]++;
+  erases += !cut;
+  return !cut;
+}
+
+static bool sim_program(uint32_t offset, const uint8_t *page)
+{
+  if (offset % FLASH_LOG_PAGE_SIZE || offset >= image.size())
+    return false;
+  if (power_lost)
+    return false;
+  bool cut = cut_now();
+  uint32_t len = cut ? rng() % FLASH_LOG_PAGE_SIZE : FLASH_LOG_PAGE_SIZE;
+  for (uint32_t i = 0; i < len; i++)
+    image[offset + i] &= page[i]; // NOR: só zera bits
+  return !cut;
+}
+
+struct Check
+{
+  std::vector<uint32_t> minutes; // Minuto de cada registro lido, em ordem
+  uint32_t last_seq;
+  bool first;
+  bool ordered;
+};
+
+static void collect(const FlashLogRecord *rec, void *ctx)
+{
+  Check *c = (Check *)ctx;
+  if (!c->first && rec->seq <= c->last_seq)
+    c->ordered = false;
+  c->first = false;
+  c->last_seq = rec->seq;
+  c->minutes.push_back(rec->minute);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t sectors = argc > 1 ? atoi(argv[1]) : 8;
+  uint32_t minutes = argc > 2 ? atoi(argv[2]) : 20000;
+  rng_state = argc > 3 ? atoi(argv[3]) : 1;
+  uint32_t preerase = argc > 4 ? atoi(argv[4]) : 2;
+  if (preerase > sectors - 2)
+    preerase = sectors - 2;
+
+  image.assign(sectors * FLASH_LOG_SECTOR_SIZE, 0x00); // Flash nunca apagada
+  erase_count.assign(sectors, 0);
+
+  FlashLogIo io = {image.data(), sectors, sim_erase, sim_program};
+  static FlashLog log;
+  flash_log_init(&log, &io);
+  flash_log_prepare(&log, preerase);
+
+  std::vector<uint32_t> durable;  // Minutos que devem estar na flash
+  std::vector<uint32_t> pending;  // Minutos ainda na página em RAM
+  std::vector<uint32_t> written;  // Todos os minutos entregues ao registro
+  std::vector<uint32_t> cut_at;   // Minuto de cada corte de energia
+  uint32_t boots = 0, cuts = 0, errors = 0;
+  uint32_t opened = 0, late_erases = 0; // Setores abertos nesta inicialização
+
+  for (uint32_t minute = 0; minute < minutes; minute++)
+  {
+    // De vez em quando agenda um corte de energia nas próximas operações
+    if (cut_in < 0 && rng() % 200 == 0)
+      cut_in = 1 + rng() % 3;
+
+    FlashLogRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.minute = minute;
+    rec.boot = (uint16_t)boots;
+    uint32_t sector = log.sector, erases_before = erases;
+    flash_log_append(&log, &rec);
+    if (log.sector != sector && ++opened <= preerase && erases != erases_before)
+      late_erases++;
+    written.push_back(minute); // Pode ter chegado à flash mesmo com corte
+
+    if (power_lost)
+    {
+      // O que estava na RAM se perde; reinicializa a partir da imagem
+      cuts++;
+      cut_at.push_back(minute);
+      boots++;
+      power_lost = false;
+      cut_in = -1;
+      pending.clear();
+      opened = 0;
+      flash_log_init(&log, &io);
+      // O apagamento antecipado também pode ser cortado; a próxima inicialização refaz
+      if (rng() % 4 == 0)
+        cut_in = 1;
+      flash_log_prepare(&log, preerase);
+      while (power_lost)
+      {
+        boots++;
+        power_lost = false;
+        cut_in = -1;
+        flash_log_init(&log, &io);
+        flash_log_prepare(&log, preerase);
+      }
+      continue;
+    }
+
+    pending.push_back(minute);
+    if (log.page_used == 0)
+    {
+      durable.insert(durable.end(), pending.begin(), pending.end());
+      pending.clear();
+    }
+  }
+
+  // Confere o conteúdo: os registros duráveis mais recentes que cabem na região
+  Check c = {{}, 0, true, true};
+  flash_log_for_each(&log, collect, &c);
+  if (!c.ordered)
+  {
+    printf("FALHA: registros fora de ordem\n");
+    errors++;
+  }
+
+  // Todo registro lido precisa ter sido gravado; a partir do mais antigo lido, todo
+  // registro durável precisa ter sido lido. Um corte pode deixar registros inteiros
+  // na página interrompida, e eles também são aceitos.
+  std::vector<bool> was_written(minutes, false), was_read(minutes, false);
+  for (uint32_t m : written)
+    was_written[m] = true;
+  for (uint32_t m : c.minutes)
+  {
+    if (m >= minutes || !was_written[m])
+    {
+      printf("FALHA: registro do minuto %u nunca foi gravado\n", m);
+      errors++;
+      break;
+    }
+    was_read[m] = true;
+  }
+  uint32_t oldest = c.minutes.empty() ? minutes : c.minutes.front();
+  size_t missing = 0, kept = 0;
+  for (uint32_t m : durable)
+    if (m >= oldest)
+    {
+      kept++;
+      if (!was_read[m])
+        missing++;
+    }
+  if (missing)
+  {
+    printf("FALHA: %zu registros duráveis perdidos\n", missing);
+    errors++;
+  }
+  // A região guarda pelo menos (setores - 1 - adiantados) setores cheios de histórico,
+  // menos uma página inutilizada por corte dentro dessa janela
+  size_t capacity = (size_t)(sectors - 1 - preerase) * (FLASH_LOG_SLOTS_PER_SECTOR - 1);
+  for (uint32_t m : cut_at)
+    if (m >= oldest && capacity >= FLASH_LOG_SLOTS_PER_PAGE)
+      capacity -= FLASH_LOG_SLOTS_PER_PAGE;
+  if (kept < capacity && kept < durable.size())
+  {
+    printf("FALHA: só %zu registros duráveis mantidos (capacidade %zu)\n", kept, capacity);
+    errors++;
+  }
+
+  uint32_t emin = UINT32_MAX, emax = 0;
+  for (uint32_t e : erase_count)
+  {
+    emin = e < emin ? e : emin;
+    emax = e > emax ? e : emax;
+  }
+  if (emax - emin > 1 + cuts)
+  {
+    printf("FALHA: desgaste desigual (apagamentos %u..%u)\n", emin, emax);
+    errors++;
+  }
+
+  if (late_erases)
+  {
+    printf("FALHA: %u setores adiantados apagados de novo durante a gravação\n", late_erases);
+    errors++;
+  }
+
+  printf("setores=%u minutos=%u cortes=%u lidos=%zu duraveis=%zu apagamentos=%u..%u ignorados=%u adiantados=%u\n",
+         sectors, minutes, cuts, c.minutes.size(), durable.size(), emin, emax, log.torn, preerase);
+  printf(errors ? "FALHOU\n" : "OK\n");
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+# Gera ssd1306_font.h a partir dos desenhos abaixo (5x7, linha 7 para descendentes).
+#   python3 tools/gen_font.py > ssd1306_font.h
+#
+# Saídas: índice de 256 entradas (caractere -> glifo), fonte monoespaçada 8x8
+# (glifo nas colunas 1 a 5) e fonte proporcional (colunas vazias removidas).
+
+GLYPHS = {
+    ' ': [],
+    '!': ["..#..", "..#..", "..#..", "..#..", "..#..", ".....", "..#.."],
+    '"': [".#.#.", ".#.#."],
+    '#': [".#.#.", ".#.#.", "#####", ".#.#.", "#####", ".#.#.", ".#.#."],
+    '$': ["..#..", ".####", "#.#..", ".###.", "..#.#", "####.", "..#.."],
+    '%': ["##...", "##..#", "...#.", "..#..", ".#...", "#..##", "...##"],
+    '&': [".##..", "#..#.", "#.#..", ".#...", "#.#.#", "#..#.", ".##.#"],
+    "'": ["..#..", "..#..", ".#..."],
+    '(': ["...#.", "..#..", ".#...", ".#...", ".#...", "..#..", "...#."],
+    ')': [".#...", "..#..", "...#.", "...#.", "...#.", "..#..", ".#..."],
+    '*': [".....", "..#..", "#.#.#", ".###.", "#.#.#", "..#..", "....."],
+    '+': [".....", "..#..", "..#..", "#####", "..#..", "..#..", "....."],
+    ',': [".....", ".....", ".....", ".....", ".....", ".##..", "..#..", ".#..."],
+    '-': [".....", ".....", ".....", "#####"],
+    '.': [".....", ".....", ".....", ".....", ".....", ".##..", ".##.."],
+    '/': [".....", "....#", "...#.", "..#..", ".#...", "#....", "....."],
+    '0': [".###.", "#...#", "#..##", "#.#.#", "##..#", "#...#", ".###."],
+    '1': ["..#..", ".##..", "..#..", "..#..", "..#..", "..#..", ".###."],
+    '2': [".###.", "#...#", "....#", "...#.", "..#..", ".#...", "#####"],
+    '3': ["#####", "...#.", "..#..", "...#.", "....#", "#...#", ".###."],
+    '4': ["...#.", "..##.", ".#.#.", "#..#.", "#####", "...#.", "...#."],
+    '5': ["#####", "#....", "####.", "....#", "....#", "#...#", ".###."],
+    '6': ["..##.", ".#...", "#....", "####.", "#...#", "#...#", ".###."],
+    '7': ["#####", "....#", "...#.", "..#..", ".#...", ".#...", ".#..."],
+    '8': [".###.", "#...#", "#...#", ".###.", "#...#", "#...#", ".###."],
+    '9': [".###.", "#...#", "#...#", ".####", "....#", "...#.", ".##.."],
+    ':': [".....", ".##..", ".##..", ".....", ".##..", ".##..", "....."],
+    ';': [".....", ".##..", ".##..", ".....", ".##..", "..#..", ".#..."],
+    '<': ["...#.", "..#..", ".#...", "#....", ".#...", "..#..", "...#."],
+    '=': [".....", ".....", "#####", ".....", "#####", ".....", "....."],
+    '>': [".#...", "..#..", "...#.", "....#", "...#.", "..#..", ".#..."],
+    '?': [".###.", "#...#", "....#", "...#.", "..#..", ".....", "..#.."],
+    '@': [".###.", "#...#", "....#", ".##.#", "#.#.#", "#.#.#", ".###."],
+    'A': [".###.", "#...#", "#...#", "#####", "#...#", "#...#", "#...#"],
+    'B': ["####.", "#...#", "#...#", "####.", "#...#", "#...#", "####."],
+    'C': [".###.", "#...#", "#....", "#....", "#....", "#...#", ".###."],
+    'D': ["###..", "#..#.", "#...#", "#...#", "#...#", "#..#.", "###.."],
+    'E': ["#####", "#....", "#....", "####.", "#....", "#....", "#####"],
+    'F': ["#####", "#....", "#....", "####.", "#....", "#....", "#...."],
+    'G': [".###.", "#...#", "#....", "#.###", "#...#", "#...#", ".####"],
+    'H': ["#...#", "#...#", "#...#", "#####", "#...#", "#...#", "#...#"],
+    'I': [".###.", "..#..", "..#..", "..#..", "..#..", "..#..", ".###."],
+    'J': ["..###", "...#.", "...#.", "...#.", "...#.", "#..#.", ".##.."],
+    'K': ["#...#", "#..#.", "#.#..", "##...", "#.#..", "#..#.", "#...#"],
+    'L': ["#....", "#....", "#....", "#....", "#....", "#....", "#####"],
+    'M': ["#...#", "##.##", "#.#.#", "#.#.#", "#...#", "#...#", "#...#"],
+    'N': ["#...#", "#...#", "##..#", "#.#.#", "#..##", "#...#", "#...#"],
+    'O': [".###.", "#...#", "#...#", "#...#", "#...#", "#...#", ".###."],
+    'P': ["####.", "#...#", "#...#", "####.", "#....", "#....", "#...."],
+    'Q': [".###.", "#...#", "#...#", "#...#", "#.#.#", "#..#.", ".##.#"],
+    'R': ["####.", "#...#", "#...#", "####.", "#.#..", "#..#.", "#...#"],
+    'S': [".####", "#....", "#....", ".###.", "....#", "....#", "####."],
+    'T': ["#####", "..#..", "..#..", "..#..", "..#..", "..#..", "..#.."],
+    'U': ["#...#", "#...#", "#...#", "#...#", "#...#", "#...#", ".###."],
+    'V': ["#...#", "#...#", "#...#", "#...#", "#...#", ".#.#.", "..#.."],
+    'W': ["#...#", "#...#", "#...#", "#.#.#", "#.#.#", "#.#.#", ".#.#."],
+    'X': ["#...#", "#...#", ".#.#.", "..#..", ".#.#.", "#...#", "#...#"],
+    'Y': ["#...#", "#...#", ".#.#.", "..#..", "..#..", "..#..", "..#.."],
+    'Z': ["#####", "....#", "...#.", "..#..", ".#...", "#....", "#####"],
+    '[': [".###.", ".#...", ".#...", ".#...", ".#...", ".#...", ".###."],
+    '\\': [".....", "#....", ".#...", "..#..", "...#.", "....#", "....."],
+    ']': [".###.", "...#.", "...#.", "...#.", "...#.", "...#.", ".###."],
+    '^': ["..#..", ".#.#.", "#...#"],
+    '_': [".....", ".....", ".....", ".....", ".....", ".....", "#####"],
+    '`': [".#...", "..#..", "...#."],
+    'a': [".....", ".....", ".###.", "....#", ".####", "#...#", ".####"],
+    'b': ["#....", "#....", "#.##.", "##..#", "#...#", "#...#", "####."],
+    'c': [".....", ".....", ".###.", "#....", "#....", "#...#", ".###."],
+    'd': ["....#", "....#", ".##.#", "#..##", "#...#", "#...#", ".####"],
+    'e': [".....", ".....", ".###.", "#...#", "#####", "#....", ".###."],
+    'f': ["..##.", ".#..#", ".#...", "###..", ".#...", ".#...", ".#..."],
+    'g': [".....", ".....", ".####", "#...#", "#...#", ".####", "....#", ".###."],
+    'h': ["#....", "#....", "#.##.", "##..#", "#...#", "#...#", "#...#"],
+    'i': ["..#..", ".....", ".##..", "..#..", "..#..", "..#..", ".###."],
+    'j': ["...#.", ".....", "..##.", "...#.", "...#.", "...#.", "#..#.", ".##.."],
+    'k': ["#....", "#....", "#..#.", "#.#..", "##...", "#.#..", "#..#."],
+    'l': [".##..", "..#..", "..#..", "..#..", "..#..", "..#..", ".###."],
+    'm': [".....", ".....", "##.#.", "#.#.#", "#.#.#", "#...#", "#...#"],
+    'n': [".....", ".....", "#.##.", "##..#", "#...#", "#...#", "#...#"],
+    'o': [".....", ".....", ".###.", "#...#", "#...#", "#...#", ".###."],
+    'p': [".....", ".....", "####.", "#...#", "#...#", "####.", "#....", "#...."],
+    'q': [".....", ".....", ".####", "#...#", "#...#", ".####", "....#", "....#"],
+    'r': [".....", ".....", "#.##.", "##..#", "#....", "#....", "#...."],
+    's': [".....", ".....", ".####", "#....", ".###.", "....#", "####."],
+    't': [".#...", ".#...", "###..", ".#...", ".#...", ".#..#", "..##."],
+    'u': [".....", ".....", "#...#", "#...#", "#...#", "#..##", ".##.#"],
+    'v': [".....", ".....", "#...#", "#...#", "#...#", ".#.#.", "..#.."],
+    'w': [".....", ".....", "#...#", "#...#", "#.#.#", "#.#.#", ".#.#."],
+    'x': [".....", ".....", "#...#", ".#.#.", "..#..", ".#.#.", "#...#"],
+    'y': [".....", ".....", "#...#", "#...#", "#...#", ".####", "....#", ".###."],
+    'z': [".....", ".....", "#####", "...#.", "..#..", ".#...", "#####"],
+    '{': ["...#.", "..#..", "..#..", ".#...", "..#..", "..#..", "...#."],
+    '|': ["..#..", "..#..", "..#..", "..#..", "..#..", "..#..", "..#.."],
+    '}': [".#...", "..#..", "..#..", "...#.", "..#..", "..#..", ".#..."],
+    '~': [".....", ".....", ".#...", "#.#.#", "...#.", ".....", "....."],
+    '\xb0': [".##..", "#..#.", "#..#.", ".##.."],  # grau (Latin-1)
+}
+
+SPACE_WIDTH = 3  # Largura do espaço na fonte proporcional
+
+
+def columns(rows):
+    rows = rows + ["....."] * (8 - len(rows))
+    assert len(rows) == 8 and all(len(r) == 5 for r in rows), rows
+    return [sum(1 << y for y in range(8) if rows[y][x] == '#') for x in range(5)]
+
+
+def main():
+    chars = sorted(GLYPHS, key=ord)
+    cols = [columns(GLYPHS[c]) for c in chars]
+    index = [0] * 256
+    for i, c in enumerate(chars):
+        index[ord(c)] = i
+
+    out = []
+    out.append("// Generated by tools/gen_font.py - edit the drawings there, not this file.")
+    out.append("//")
+    out.append("// Printable ASCII plus the degree sign (Latin-1 0xB0), 5x7 with one row for")
+    out.append("// descenders. Glyphs are vertical bytes (bit 0 on top) so they copy straight")
+    out.append("// into a frame buffer page. Every table is const and stays in flash.")
+    out.append("")
+    out.append("#define FONT_GLYPHS %d" % len(chars))
+    out.append("#define FONT_MONO_WIDTH 8")
+    out.append("#define FONT_HEIGHT 8")
+    out.append("")
+    out.append("// Character code -> glyph; undefined codes map to glyph 0 (space)")
+    out.append("static const uint8_t font_index[256] = {")
+    for i in range(0, 256, 16):
+        out.append("    " + " ".join("%3d," % v for v in index[i:i + 16]))
+    out.append("};")
+    out.append("")
+    out.append("// Monospaced: 8 columns per glyph, glyph in columns 1-5")
+    out.append("static const uint8_t font_mono[FONT_GLYPHS][FONT_MONO_WIDTH] = {")
+    for c, g in zip(chars, cols):
+        cell = [0] + g + [0, 0]
+        name = "space" if c == ' ' else c if c != '\\' and ord(c) < 128 else "0x%02X" % ord(c)
+        out.append("    {" + ", ".join("0x%02x" % b for b in cell) + "}, // " + name)
+    out.append("};")
+    out.append("")
+
+    data, glyphs = [], []
+    for c, g in zip(chars, cols):
+        used = [x for x in range(5) if g[x]]
+        trimmed = g[used[0]:used[-1] + 1] if used else [0] * SPACE_WIDTH
+        glyphs.append((len(data), len(trimmed)))
+        data += trimmed
+    out.append("// Proportional: blank columns trimmed, one column of spacing added when drawing")
+    out.append("typedef struct {")
+    out.append("    uint16_t offset; // first column in font_prop_data")
+    out.append("    uint8_t width;")
+    out.append("} FontPropGlyph;")
+    out.append("")
+    out.append("static const FontPropGlyph font_prop[FONT_GLYPHS] = {")
+    for i in range(0, len(glyphs), 8):
+        out.append("    " + " ".join("{%d, %d}," % g for g in glyphs[i:i + 8]))
+    out.append("};")
+    out.append("")
+    out.append("static const uint8_t font_prop_data[%d] = {" % len(data))
+    for i in range(0, len(data), 16):
+        out.append("    " + " ".join("0x%02x," % b for b in data[i:i + 16]))
+    out.append("};")
+    print("\n".join(out))
+
+
+main()
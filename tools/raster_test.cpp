@@ -0,0 +1,185 @@
+// Teste das primitivas de desenho de display.h (roda no host).
+//
+// Cada primitiva é comparada, pixel a pixel, com uma versão de referência feita
+// só com SetPixel() (o DrawLine original, ponto a ponto), em buffers com conteúdo
+// aleatório e coordenadas sorteadas que incluem casos parcial ou totalmente fora
+// da tela. Também confere o texto em qualquer y contra a mesma referência.
+//
+// Compilação e uso:
+//   g++ -std=c++17 -O2 -DSIMIS_HOST -I. tools/raster_test.cpp -o raster_test   (na raiz)
+//   ./raster_test [casos por primitiva] [semente]
+// Sai com código 1 se alguma comparação falhar.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hal.h"
+#include "ssd1306_font.h"
+#include "display.h"
+
+static uint32_t rng_state = 1;
+
+static uint32_t rng()
+{
+  rng_state = rng_state * 1664525u + 1013904223u;
+  return rng_state >> 8;
+}
+
+// Coordenada na faixa [-margem, tamanho + margem)
+static int coord(int size, int margin)
+{
+  return (int)(rng() % (size + 2 * margin)) - margin;
+}
+
+static void ref_pixel(uint8_t *buf, int x, int y, bool on)
+{
+  if (x >= 0 && x < SSD1306_WIDTH && y >= 0 && y < SSD1306_HEIGHT)
+    SetPixel(buf, x, y, on);
+}
+
+static void ref_fill_rect(uint8_t *buf, int x, int y, int w, int h, bool on)
+{
+  for (int j = y; j < y + h; j++)
+    for (int i = x; i < x + w; i++)
+      ref_pixel(buf, i, j, on);
+}
+
+static void ref_rect(uint8_t *buf, int x, int y, int w, int h, bool on)
+{
+  if (w <= 0 || h <= 0)
+    return;
+  for (int i = x; i < x + w; i++)
+  {
+    ref_pixel(buf, i, y, on);
+    ref_pixel(buf, i, y + h - 1, on);
+  }
+  for (int j = y; j < y + h; j++)
+  {
+    ref_pixel(buf, x, j, on);
+    ref_pixel(buf, x + w - 1, j, on);
+  }
+}
+
+static void ref_line(uint8_t *buf, int x0, int y0, int x1, int y1, bool on)
+{
+  int dx = abs(x1 - x0);
+  int sx = x0 < x1 ? 1 : -1;
+  int dy = -abs(y1 - y0);
+  int sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+  while (true)
+  {
+    ref_pixel(buf, x0, y0, on);
+    if (x0 == x1 && y0 == y1)
+      break;
+    int e2 = 2 * err;
+    if (e2 >= dy)
+    {
+      err += dy;
+      x0 += sx;
+    }
+    if (e2 <= dx)
+    {
+      err += dx;
+      y0 += sy;
+    }
+  }
+}
+
+static void ref_bar_meter(uint8_t *buf, int x, int y, int w, int h, int level)
+{
+  level = level < 0 ? 0 : level > h ? h : level;
+  ref_fill_rect(buf, x, y, w, h - level, false);
+  ref_fill_rect(buf, x, y + h - level, w, level, true);
+}
+
+static void ref_string(uint8_t *buf, int x, int y, const char *str)
+{
+  for (; *str; str++, x += FONT_MONO_WIDTH)
+  {
+    const uint8_t *g = font_mono[font_index[(uint8_t)*str]];
+    for (int c = 0; c < FONT_MONO_WIDTH; c++)
+      for (int r = 0; r < FONT_HEIGHT; r++)
+        ref_pixel(buf, x + c, y + r, (g[c] >> r) & 1);
+  }
+}
+
+static uint8_t fast[SSD1306_BUF_LEN], ref[SSD1306_BUF_LEN];
+static int failures = 0;
+
+static void randomize()
+{
+  for (int i = 0; i < (int)SSD1306_BUF_LEN; i++)
+    fast[i] = ref[i] = (uint8_t)rng();
+}
+
+static bool same(const char *what, int a, int b, int c, int d)
+{
+  if (memcmp(fast, ref, sizeof(fast)) == 0)
+    return true;
+  for (int i = 0; i < (int)SSD1306_BUF_LEN; i++)
+    if (fast[i] != ref[i])
+    {
+      printf("FALHA: %s(%d, %d, %d, %d): byte %d (x=%d página=%d) %02x != %02x\n", what, a, b, c, d, i,
+             i % SSD1306_WIDTH, i / SSD1306_WIDTH, fast[i], ref[i]);
+      break;
+    }
+  failures++;
+  return false;
+}
+
+int main(int argc, char **argv)
+{
+  int cases = argc > 1 ? atoi(argv[1]) : 20000;
+  rng_state = argc > 2 ? (uint32_t)atoi(argv[2]) : 1;
+  const int M = 20; // Margem fora da tela
+
+  for (int n = 0; n < cases && failures < 10; n++)
+  {
+    bool on = rng() & 1;
+    int x = coord(SSD1306_WIDTH, M), y = coord(SSD1306_HEIGHT, M);
+    int x1 = coord(SSD1306_WIDTH, M), y1 = coord(SSD1306_HEIGHT, M);
+    int w = (int)(rng() % 80) - 4, h = (int)(rng() % 50) - 4;
+
+    randomize();
+    FillRect(fast, x, y, w, h, on);
+    ref_fill_rect(ref, x, y, w, h, on);
+    same("FillRect", x, y, w, h);
+
+    randomize();
+    DrawRect(fast, x, y, w, h, on);
+    ref_rect(ref, x, y, w, h, on);
+    same("DrawRect", x, y, w, h);
+
+    randomize();
+    DrawHLine(fast, x, x1, y, on);
+    ref_line(ref, x, y, x1, y, on);
+    same("DrawHLine", x, x1, y, on);
+
+    randomize();
+    DrawVLine(fast, x, y, y1, on);
+    ref_line(ref, x, y, x, y1, on);
+    same("DrawVLine", x, y, y1, on);
+
+    randomize();
+    DrawLine(fast, x, y, x1, y1, on);
+    ref_line(ref, x, y, x1, y1, on);
+    same("DrawLine", x, y, x1, y1);
+
+    int level = (int)(rng() % (h + 10 > 0 ? h + 10 : 1)) - 4;
+    randomize();
+    DrawBarMeter(fast, x, y, w, h, level);
+    ref_bar_meter(ref, x, y, w, h, level);
+    same("DrawBarMeter", x, y, w, level);
+
+    randomize();
+    WriteString(fast, (int16_t)x, (int16_t)y, "Ab%-9.q");
+    ref_string(ref, x, y, "Ab%-9.q");
+    same("WriteString", x, y, 0, 0);
+  }
+
+  printf("casos=%d falhas=%d\n", cases, failures);
+  printf(failures ? "FALHOU\n" : "OK\n");
+  return failures ? 1 : 0;
+}
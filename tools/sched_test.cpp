@@ -0,0 +1,133 @@
+// Teste do escalonador de sched.h com um relógio virtual (roda no host).
+//
+// As tarefas não fazem nada além de avançar o relógio pelo tempo de execução que
+// o cenário define, e o laço de teste faz o papel de main(): roda sched_step() e
+// "dorme" avançando o relógio pelo que ela devolve. Confere:
+// - taxa fixa: depois de muitos períodos as liberações continuam na grade, sem deriva;
+// - ordem EDF entre tarefas liberadas juntas;
+// - contagem de perdas de prazo por tarefa e recuperação sem rajada depois de uma
+//   execução longa.
+//
+// Compilação e uso:
+//   g++ -std=c++17 -O2 -I. tools/sched_test.cpp -o sched_test   (na raiz)
+//   ./sched_test
+// Sai com código 1 se alguma verificação falhar.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sched.h"
+
+static uint64_t clock_us = 0;
+static int failures = 0;
+
+static uint64_t virtual_now()
+{
+  return clock_us;
+}
+
+static void check(bool ok, const char *what)
+{
+  printf("%-48s %s\n", what, ok ? "ok" : "FALHOU");
+  if (!ok)
+    failures++;
+}
+
+// Duração de cada tarefa e registro da ordem em que rodaram
+static uint32_t cost_us[3];
+static char trace[64];
+static size_t trace_len = 0;
+static uint64_t last_start_b = 0;
+static int32_t long_run_at = -1; // Execução de "a" que demora 5 períodos (-1 = nenhuma)
+
+static void record(char c)
+{
+  if (trace_len < sizeof(trace) - 1)
+    trace[trace_len++] = c;
+}
+
+static void task_a()
+{
+  static int32_t n = 0;
+  record('a');
+  clock_us += n++ == long_run_at ? 5 * 20000 : cost_us[0];
+}
+
+static void task_b()
+{
+  record('b');
+  last_start_b = clock_us;
+  clock_us += cost_us[1];
+}
+
+static void task_c()
+{
+  record('c');
+  clock_us += cost_us[2];
+}
+
+// Roda o escalonador até o relógio virtual passar de end_us
+static void run_until(Scheduler *s, uint64_t end_us)
+{
+  while (clock_us < end_us)
+    clock_us += sched_step(s);
+}
+
+int main()
+{
+  // Entrada a 50 Hz, interface a 10 Hz com prazo curto, histórico a 1 Hz
+  SchedTask tasks[3] = {
+      {"a", task_a, 20000},
+      {"b", task_b, 100000, 30000},
+      {"c", task_c, 1000000},
+  };
+  Scheduler s;
+
+  // Tudo liberado junto em t = 0: roda primeiro o prazo mais cedo (a: 20 ms,
+  // b: 30 ms, c: 1 s)
+  cost_us[0] = 500;
+  cost_us[1] = 8000;
+  cost_us[2] = 2000;
+  clock_us = 0;
+  sched_init(&s, tasks, 3, virtual_now, 0);
+  run_until(&s, 1);
+  run_until(&s, 10000);
+  check(strncmp(trace, "abc", 3) == 0, "ordem EDF na liberacao conjunta");
+
+  // Taxa fixa: 10 s depois, b rodou 100 vezes e a última começou na grade de 100 ms
+  // (só atrasada pelo que estava na frente dela), sem perdas
+  run_until(&s, 10000000);
+  check(tasks[0].runs == 500 && tasks[1].runs == 100 && tasks[2].runs == 10, "execucoes em 10 s");
+  check(last_start_b >= 9900000 && last_start_b < 9900000 + 3000, "sem deriva da grade");
+  check(tasks[0].misses == 0 && tasks[1].misses == 0 && tasks[2].misses == 0, "nenhuma perda com folga");
+  check(s.busy_us == 500 * 500 + 100 * 8000 + 10 * 2000, "tempo ocupado");
+
+  // Uma execução de b mais longa que o prazo dele conta uma perda só para b
+  cost_us[1] = 40000;
+  run_until(&s, 10100000);
+  cost_us[1] = 8000;
+  run_until(&s, 11000000);
+  check(tasks[1].misses == 1, "perda de prazo de b");
+  check(tasks[1].max_run_us == 40000, "maior duracao de b");
+
+  // a atrasa 5 períodos: as 4 liberações engolidas contam como perdas (mais a
+  // própria execução fora do prazo) e a volta é na grade, sem rajada
+  long_run_at = (int32_t)tasks[0].runs;
+  uint32_t runs_before = tasks[0].runs;
+  uint32_t misses_before = tasks[0].misses;
+  uint64_t start = clock_us;
+  run_until(&s, start + 200000);
+  check(tasks[0].misses - misses_before == 5, "perdas do atraso longo");
+  check(tasks[0].runs - runs_before == 6, "recuperacao sem rajada");
+  check(tasks[0].release_us % 20000 == 0, "volta a grade de a");
+
+  // Nada liberado: sched_step devolve quanto falta para a próxima liberação
+  clock_us = tasks[0].release_us - 1234;
+  for (int i = 0; i < 3; i++)
+    if (tasks[i].release_us < clock_us)
+      tasks[i].release_us = clock_us + 5000;
+  check(sched_step(&s) == 1234, "tempo ate a proxima liberacao");
+
+  printf(failures ? "FALHOU\n" : "OK\n");
+  return failures ? 1 : 0;
+}
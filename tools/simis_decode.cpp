@@ -0,0 +1,261 @@
+// Decodificador da telemetria do SIMIS (telemetry.h) para CSV, no Linux.
+//
+// Lê o fluxo da porta serial USB (ou da entrada padrão com "-"), separa os quadros
+// COBS no 0x00, confere o CRC e grava um CSV por tipo de quadro:
+//   <prefixo>_level.csv, <prefixo>_alarm.csv, <prefixo>_timing.csv, <prefixo>_status.csv,
+//   <prefixo>_history.csv
+// No fim (EOF, Ctrl+C ou -n quadros) mostra na saída de erro quantos quadros foram
+// aceitos, rejeitados pelo CRC e perdidos (lacunas em seq).
+//
+// Compilação (na raiz do repositório):
+//   g++ -std=c++17 -O2 -I. tools/simis_decode.cpp -o simis_decode
+// Uso:
+//   ./simis_decode [-n quadros] [-r divisor] [-p 0|1] [-H] /dev/ttyACM0 turno1
+// -r envia o divisor de TEL_LEVEL (0 a 9) ao firmware antes de ler; -p desliga (0) ou
+// liga (1) o modo de baixo consumo, para comparar o consumo estimado nos dois casos;
+// -H pede o histórico em flash, um registro por minuto, para auditar a jornada.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "telemetry.h"
+
+static const char *weighting_names[] = {"A", "C", "Z"};
+static const char *alarm_state_names[] = {"ocioso", "disparado", "reconhecido", "rearmado"};
+static const char *display_names[] = {"aceso", "reduzido", "apagado"};
+static const char *reset_names[] = {"energia", "pino", "watchdog"};
+static const char *shift_names[] = {"nova", "retomada", "pendente"};
+
+static volatile sig_atomic_t stop = 0;
+
+static void on_signal(int)
+{
+  stop = 1;
+}
+
+static const char *name_of(const char *const *names, size_t count, unsigned v)
+{
+  return v < count ? names[v] : "?";
+}
+
+struct Outputs
+{
+  FILE *level, *alarm, *timing, *status, *history;
+};
+
+static FILE *open_csv(const char *prefix, const char *kind, const char *header)
+{
+  char path[512];
+  snprintf(path, sizeof(path), "%s_%s.csv", prefix, kind);
+  FILE *f = fopen(path, "w");
+  if (!f)
+  {
+    perror(path);
+    exit(1);
+  }
+  fprintf(f, "%s\n", header);
+  fflush(f);
+  return f;
+}
+
+// Grava uma linha do quadro; retorna false se o tipo ou o tamanho não forem conhecidos
+static bool write_row(const Outputs &out, uint8_t type, const uint8_t *payload, size_t len)
+{
+  switch (type)
+  {
+  case TEL_LEVEL:
+  {
+    TelLevel m;
+    if (len != sizeof(m))
+      return false;
+    memcpy(&m, payload, sizeof(m));
+    fprintf(out.level, "%u,%.2f,%.2f,%.2f,%.2f,%s,%s\n", m.block, m.level_cdb / 100.0, m.recent_leq_cdb / 100.0,
+            m.dose_niosh / 100.0, m.dose_osha / 100.0, name_of(weighting_names, 3, m.weighting),
+            name_of(alarm_state_names, 4, m.alarm_state));
+    fflush(out.level);
+    return true;
+  }
+  case TEL_ALARM:
+  {
+    TelAlarm m;
+    if (len != sizeof(m))
+      return false;
+    memcpy(&m, payload, sizeof(m));
+    m.reason[sizeof(m.reason) - 1] = '\0';
+    fprintf(out.alarm, "%u,%s,%s,\"%s\"\n", m.block, name_of(alarm_state_names, 4, m.previous),
+            name_of(alarm_state_names, 4, m.state), m.reason);
+    fflush(out.alarm);
+    return true;
+  }
+  case TEL_TIMING:
+  {
+    TelTiming m;
+    if (len != sizeof(m))
+      return false;
+    memcpy(&m, payload, sizeof(m));
+    fprintf(out.timing, "%u,%u,%u,%u,%u,%u,%u,%u,%u\n", m.block, m.capture_us, m.bands_us, m.level_us, m.frame_us,
+            m.render_wait_us, m.input_misses, m.frame_misses, m.history_misses);
+    fflush(out.timing);
+    return true;
+  }
+  case TEL_STATUS:
+  {
+    TelStatus m;
+    if (len != sizeof(m))
+      return false;
+    memcpy(&m, payload, sizeof(m));
+    fprintf(out.status, "%u,%u,%u,%u,%u,%u,%.2f,%.1f,%u,%s,%u\n", m.block, m.lost, m.overruns, m.fifo_overflows, m.oled_bytes,
+            m.oled_errors, m.mic_baseline_q4 / 16.0, m.power_mw_x10 / 10.0, m.clock_mhz, name_of(display_names, 3, m.display),
+            m.over_range);
+    fflush(out.status);
+    return true;
+  }
+  case TEL_HISTORY:
+  {
+    TelHistory m;
+    if (len != sizeof(m))
+      return false;
+    memcpy(&m, payload, sizeof(m));
+    fprintf(out.history, "%u,%u,%u,%.2f,%.2f,%.2f,%.2f,%u,%u,%s,%s,%u,%s,%s\n", m.seq, m.boot, m.minute, m.leq_cdb / 100.0,
+            m.lmax_cdb / 100.0, m.dose_niosh / 100.0, m.dose_osha / 100.0, m.alarms_safe, m.alarms_volume,
+            name_of(alarm_state_names, 4, m.alarm_state), name_of(weighting_names, 3, m.weighting), m.shift_minutes,
+            name_of(reset_names, 3, m.reset_reason), name_of(shift_names, 3, m.shift));
+    fflush(out.history);
+    return true;
+  }
+  }
+  return false;
+}
+
+int main(int argc, char **argv)
+{
+  long max_frames = -1;
+  int divider = -1, low_power = -1;
+  bool history = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "n:r:p:H")) != -1)
+  {
+    if (opt == 'n')
+      max_frames = atol(optarg);
+    else if (opt == 'r')
+      divider = atoi(optarg);
+    else if (opt == 'p')
+      low_power = atoi(optarg);
+    else if (opt == 'H')
+      history = true;
+    else
+    {
+      fprintf(stderr, "uso: %s [-n quadros] [-r divisor] [-p 0|1] [-H] <dispositivo|-> <prefixo>\n", argv[0]);
+      return 2;
+    }
+  }
+  if (argc - optind != 2)
+  {
+    fprintf(stderr, "uso: %s [-n quadros] [-r divisor] [-p 0|1] [-H] <dispositivo|-> <prefixo>\n", argv[0]);
+    return 2;
+  }
+
+  const char *device = argv[optind];
+  int fd = strcmp(device, "-") == 0 ? STDIN_FILENO : open(device, O_RDWR | O_NOCTTY);
+  if (fd < 0)
+  {
+    perror(device);
+    return 1;
+  }
+  if (isatty(fd))
+  {
+    struct termios tio;
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    cfsetspeed(&tio, B115200);
+    tcsetattr(fd, TCSANOW, &tio);
+  }
+  if (divider >= 0 && divider <= 9)
+  {
+    char c = (char)('0' + divider);
+    if (write(fd, &c, 1) != 1)
+      perror("divisor");
+  }
+  if (low_power == 0 || low_power == 1)
+  {
+    char c = low_power ? 'L' : 'N';
+    if (write(fd, &c, 1) != 1)
+      perror("modo de consumo");
+  }
+  if (history && write(fd, "H", 1) != 1)
+    perror("histórico");
+
+  Outputs out;
+  out.level = open_csv(argv[optind + 1], "level", "block,level_db,recent_leq_db,dose_niosh_pct,dose_osha_pct,weighting,alarm_state");
+  out.alarm = open_csv(argv[optind + 1], "alarm", "block,previous,state,reason");
+  out.timing = open_csv(argv[optind + 1], "timing", "block,capture_us,bands_us,level_us,frame_us,render_wait_us,input_misses,frame_misses,history_misses");
+  out.status = open_csv(argv[optind + 1], "status", "block,lost,overruns,fifo_overflows,oled_bytes,oled_errors,mic_baseline,power_mw,clock_mhz,display,over_range");
+  out.history = open_csv(argv[optind + 1], "history", "seq,boot,minute,leq_db,lmax_db,dose_niosh_pct,dose_osha_pct,alarms_dose,alarms_volume,alarm_state,weighting,shift_min,reset,shift");
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+
+  uint8_t encoded[TELEMETRY_MAX_FRAME * 4];
+  size_t enc_len = 0;
+  bool overflow = false;
+  long accepted = 0, rejected = 0, lost = 0;
+  int last_seq = -1;
+
+  while (!stop && (max_frames < 0 || accepted < max_frames))
+  {
+    uint8_t chunk[256];
+    ssize_t n = read(fd, chunk, sizeof(chunk));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+
+    for (ssize_t i = 0; i < n && (max_frames < 0 || accepted < max_frames); i++)
+    {
+      if (chunk[i] != 0x00)
+      {
+        if (enc_len < sizeof(encoded))
+          encoded[enc_len++] = chunk[i];
+        else
+          overflow = true;
+        continue;
+      }
+
+      // Fim de quadro
+      uint8_t raw[TELEMETRY_MAX_RAW];
+      size_t raw_len = overflow ? 0 : telemetry_cobs_decode(encoded, enc_len, raw, sizeof(raw));
+      uint8_t type, seq;
+      const uint8_t *payload;
+      size_t payload_len;
+      if (enc_len > 0)
+      {
+        if (raw_len && telemetry_parse(raw, raw_len, &type, &seq, &payload, &payload_len) &&
+            write_row(out, type, payload, payload_len))
+        {
+          if (last_seq >= 0)
+            lost += (uint8_t)(seq - last_seq - 1);
+          last_seq = seq;
+          accepted++;
+        }
+        else
+          rejected++;
+      }
+      enc_len = 0;
+      overflow = false;
+    }
+  }
+
+  fprintf(stderr, "quadros: aceitos=%ld rejeitados=%ld perdidos=%ld\n", accepted, rejected, lost);
+  fclose(out.level);
+  fclose(out.alarm);
+  fclose(out.timing);
+  fclose(out.status);
+  fclose(out.history);
+  return 0;
+}
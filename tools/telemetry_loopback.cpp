@@ -0,0 +1,204 @@
+// Teste do protocolo de telemetria por um pseudo-terminal (pty), no Linux.
+//
+// Faz o papel do firmware: codifica quadros com telemetry.h e os escreve no lado
+// mestre de um pty, intercalados com lixo, um quadro corrompido e um quadro pulado
+// em seq. O simis_decode lê o lado escravo como se fosse /dev/ttyACM0 e pede o
+// histórico (-H), o que confere o comando enviado. No fim os CSVs gerados são
+// comparados com o esperado.
+//
+// Compilação e uso (na raiz do repositório):
+//   g++ -std=c++17 -O2 -I. tools/simis_decode.cpp -o simis_decode
+//   g++ -std=c++17 -O2 -I. tools/telemetry_loopback.cpp -o telemetry_loopback
+//   ./telemetry_loopback ./simis_decode
+// Sai com código 1 se alguma verificação falhar.
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "telemetry.h"
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+  if (!ok)
+  {
+    printf("FALHA: %s\n", what);
+    failures++;
+  }
+}
+
+static std::vector<std::string> read_lines(const std::string &path)
+{
+  std::vector<std::string> lines;
+  FILE *f = fopen(path.c_str(), "r");
+  if (!f)
+    return lines;
+  char line[512];
+  while (fgets(line, sizeof(line), f))
+  {
+    line[strcspn(line, "\n")] = '\0';
+    lines.push_back(line);
+  }
+  fclose(f);
+  return lines;
+}
+
+static void send(int fd, const uint8_t *data, size_t len)
+{
+  while (len > 0)
+  {
+    ssize_t n = write(fd, data, len);
+    if (n <= 0)
+    {
+      perror("write");
+      exit(1);
+    }
+    data += n;
+    len -= n;
+  }
+}
+
+static uint8_t seq = 0;
+
+static void send_frame(int fd, uint8_t type, const void *payload, size_t len)
+{
+  uint8_t frame[TELEMETRY_MAX_FRAME];
+  size_t n = telemetry_frame(type, seq++, payload, len, frame);
+  send(fd, frame, n);
+}
+
+int main(int argc, char **argv)
+{
+  const char *decoder = argc > 1 ? argv[1] : "./simis_decode";
+  char prefix[] = "/tmp/simis_loopbackXXXXXX";
+  int tmp = mkstemp(prefix);
+  if (tmp < 0)
+  {
+    perror("mkstemp");
+    return 1;
+  }
+  close(tmp);
+  unlink(prefix);
+
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) || unlockpt(master))
+  {
+    perror("pty");
+    return 1;
+  }
+  const char *slave_path = ptsname(master);
+
+  // Modo cru no escravo antes de qualquer escrita, para a disciplina de linha não
+  // mexer nos bytes (o decodificador também faz isso ao abrir)
+  int slave = open(slave_path, O_RDWR | O_NOCTTY);
+  struct termios tio;
+  tcgetattr(slave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(slave, TCSANOW, &tio);
+
+  const int level_frames = 50;
+  const long expected_frames = level_frames + 4; // + alarme, tempos, estado e histórico
+
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    char n_arg[16];
+    snprintf(n_arg, sizeof(n_arg), "%ld", expected_frames);
+    execl(decoder, decoder, "-n", n_arg, "-H", slave_path, prefix, (char *)NULL);
+    perror(decoder);
+    _exit(127);
+  }
+  usleep(200000); // Dá tempo de o decodificador abrir a porta
+
+  // -H pede o histórico com 'H' antes de ler
+  struct pollfd pfd = {master, POLLIN, 0};
+  char cmd = 0;
+  check(poll(&pfd, 1, 1000) == 1 && read(master, &cmd, 1) == 1 && cmd == 'H', "pedido do histórico");
+
+  // Lixo antes do primeiro quadro (ex.: texto de inicialização) e um quadro vazio
+  const uint8_t noise[] = {'I', '2', 'C', '\n', 0x00, 0x00};
+  send(master, noise, sizeof(noise));
+
+  for (int i = 0; i < level_frames; i++)
+  {
+    TelLevel m;
+    m.block = 100 + i;
+    m.level_cdb = (int16_t)(6000 + i * 25);
+    m.recent_leq_cdb = -150;
+    m.dose_niosh = (uint16_t)(i * 10);
+    m.dose_osha = 65535;
+    m.weighting = (uint8_t)(i % 3);
+    m.alarm_state = 1;
+    send_frame(master, TEL_LEVEL, &m, sizeof(m));
+
+    if (i == 10)
+    {
+      // Quadro com um byte trocado: o CRC deve rejeitá-lo
+      uint8_t frame[TELEMETRY_MAX_FRAME];
+      size_t n = telemetry_frame(TEL_LEVEL, seq++, &m, sizeof(m), frame);
+      frame[4] ^= 0x5A;
+      if (frame[4] == 0)
+        frame[4] = 1;
+      send(master, frame, n);
+    }
+    if (i == 20)
+      seq++; // Um quadro "perdido"
+  }
+
+  TelAlarm a;
+  memset(&a, 0, sizeof(a));
+  a.block = 150;
+  a.previous = 0;
+  a.state = 1;
+  strcpy(a.reason, "VolMax excedido");
+  send_frame(master, TEL_ALARM, &a, sizeof(a));
+
+  TelTiming t = {151, 120, 2100, 340, 9000, 15, 0, 2, 1};
+  send_frame(master, TEL_TIMING, &t, sizeof(t));
+  TelStatus s = {151, 0, 1, 2, 1030, 3, 2047 * 16 + 8, 1234, 48, 1, 4};
+  send_frame(master, TEL_STATUS, &s, sizeof(s));
+  TelHistory h = {4096, 37, 12, 8512, 9730, 4250, 611, 1, 2, 2, 0, 397, 0, 1};
+  send_frame(master, TEL_HISTORY, &h, sizeof(h));
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  check(WIFEXITED(status) && WEXITSTATUS(status) == 0, "decodificador terminou com erro");
+
+  std::string p = prefix;
+  std::vector<std::string> level = read_lines(p + "_level.csv");
+  check(level.size() == (size_t)level_frames + 1, "número de linhas de level");
+  if (level.size() > 10)
+  {
+    check(level[0] == "block,level_db,recent_leq_db,dose_niosh_pct,dose_osha_pct,weighting,alarm_state", "cabeçalho de level");
+    check(level[1] == "100,60.00,-1.50,0.00,655.35,A,disparado", "primeira linha de level");
+    check(level[level_frames] == "149,72.25,-1.50,4.90,655.35,C,disparado", "última linha de level");
+  }
+
+  std::vector<std::string> alarm = read_lines(p + "_alarm.csv");
+  check(alarm.size() == 2 && alarm[1] == "150,ocioso,disparado,\"VolMax excedido\"", "linha de alarme");
+  std::vector<std::string> timing = read_lines(p + "_timing.csv");
+  check(timing.size() == 2 && timing[1] == "151,120,2100,340,9000,15,0,2,1", "linha de tempos");
+  std::vector<std::string> st = read_lines(p + "_status.csv");
+  check(st.size() == 2 && st[1] == "151,0,1,2,1030,3,2047.50,123.4,48,reduzido,4", "linha de estado");
+  std::vector<std::string> hist = read_lines(p + "_history.csv");
+  check(hist.size() == 2 && hist[1] == "4096,12,37,85.12,97.30,42.50,6.11,1,2,reconhecido,A,397,energia,retomada",
+        "linha do histórico");
+
+  for (const char *kind : {"_level.csv", "_alarm.csv", "_timing.csv", "_status.csv", "_history.csv"})
+    unlink((p + kind).c_str());
+  close(slave);
+  close(master);
+
+  printf(failures ? "FALHOU\n" : "OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,160 @@
+// Teste dos detectores F, S, I e de pico de time_weighting.h com trens de tom (roda
+// no host).
+//
+// Os detectores recebem a mesma escala do firmware (amostras ponderadas em contagens
+// Q8, energia em Q16) e os níveis saem por tw_level_cdb() e tw_peak_cdb().
+//   - Tom contínuo de 4 kHz: LF, LS e LI acomodados ficam no nível do tom.
+//   - Trens de 4 kHz a partir do silêncio (IEC 61672-1, tabela 4, e IEC 60651 para o
+//     I): o máximo de cada detector menos o nível do tom contínuo precisa ficar a
+//     0.1 dB da resposta de referência 10 log10(1 - e^(-T/tau)).
+//   - LCpeak (IEC 61672-1, tabela 5): um ciclo de 8 kHz e meios ciclos positivo e
+//     negativo de 500 Hz pela curva C; LCpeak - LC precisa ficar dentro das
+//     tolerâncias de classe 1 em torno de 3.4 dB e 2.4 dB.
+//
+// Compilação e uso:
+//   g++ -std=c++17 -O2 -I. tools/time_weighting_test.cpp -o time_weighting_test   (na raiz)
+//   ./time_weighting_test [-v]
+// Sai com código 1 se alguma verificação falhar.
+
+#include <stdio.h>
+#include <string.h>
+
+#define MIC_SAMPLE_RATE_HZ 32000
+#include "level_db.h"
+#include "weighting.h"
+#include "time_weighting.h"
+
+static int failures = 0;
+static bool verbose = false;
+
+static void check(bool ok, const char *what)
+{
+  printf("%-48s %s\n", what, ok ? "ok" : "FALHOU");
+  if (!ok)
+    failures++;
+}
+
+#define AMPLITUDE_Q8 (1000 * 256) // Tom de 1000 contagens
+#define FS MIC_SAMPLE_RATE_HZ
+
+// Nível (dB) de um tom contínuo de amplitude a (Q8): energia média a^2 / 2
+static double tone_db(double a)
+{
+  return level_cdb_from_energy((uint64_t)(a * a / 2.0), 1, 0) * 0.01;
+}
+
+static int32_t tone(uint32_t n, double f)
+{
+  return (int32_t)lround(AMPLITUDE_Q8 * sin(2.0 * M_PI * fmod(f * n / FS, 1.0)));
+}
+
+// Maiores níveis F, S e I (dB) de um trem de 4 kHz de burst_n amostras a partir do
+// silêncio, seguido de silêncio até o S descer
+static void burst_max(uint32_t burst_n, double *f_db, double *s_db, double *i_db)
+{
+  TimeWeighting t;
+  tw_init(&t);
+  int64_t f_max = 0, s_max = 0, i_max = 0;
+  for (uint32_t n = 0; n < burst_n + 4 * FS; n++)
+  {
+    int32_t y = n < burst_n ? tone(n, 4000.0) : 0;
+    tw_run(&t, (uint64_t)((int64_t)y * y));
+    f_max = t.fast > f_max ? t.fast : f_max;
+    s_max = t.slow > s_max ? t.slow : s_max;
+    i_max = t.impulse_hold > i_max ? t.impulse_hold : i_max;
+  }
+  *f_db = tw_level_cdb(f_max, 0) * 0.01;
+  *s_db = tw_level_cdb(s_max, 0) * 0.01;
+  *i_db = tw_level_cdb(i_max, 0) * 0.01;
+}
+
+// LCpeak - LC (dB) de um sinal de len amostras de sig(n), depois de 0.5 s de
+// silêncio, contra o nível C do tom contínuo de frequência f
+static double peak_minus_level(double f, uint32_t len, double sign)
+{
+  WeightingFilter c;
+  weighting_init(&c, WEIGHT_C, FS);
+  double energy = 0.0;
+  const uint32_t settle = FS / 2, measure = FS;
+  for (uint32_t n = 0; n < settle + measure; n++)
+  {
+    int32_t x = tone(n, f) << (WEIGHTING_INPUT_SHIFT - 8);
+    int32_t y = weighting_run(&c, x) >> (WEIGHTING_INPUT_SHIFT - 8);
+    if (n >= settle)
+      energy += (double)y * y;
+  }
+  int32_t lc_cdb = level_cdb_from_energy((uint64_t)(energy / measure), 1, 0);
+
+  weighting_init(&c, WEIGHT_C, FS);
+  TimeWeighting t;
+  tw_init(&t);
+  for (uint32_t n = 0; n < settle + len + FS / 10; n++)
+  {
+    int32_t s = n >= settle && n < settle + len ? (int32_t)(sign * tone(n - settle, f)) : 0;
+    int32_t y = weighting_run(&c, s << (WEIGHTING_INPUT_SHIFT - 8)) >> (WEIGHTING_INPUT_SHIFT - 8);
+    tw_peak(&t, y);
+  }
+  return (tw_peak_cdb(t.peak, 0) - lc_cdb) * 0.01;
+}
+
+int main(int argc, char **argv)
+{
+  verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+  double steady = tone_db(AMPLITUDE_Q8);
+
+  // Tom contínuo
+  TimeWeighting t;
+  tw_init(&t);
+  for (uint32_t n = 0; n < 10 * FS; n++)
+  {
+    int32_t y = tone(n, 4000.0);
+    tw_run(&t, (uint64_t)((int64_t)y * y));
+  }
+  double lf = tw_level_cdb(t.fast, 0) * 0.01, ls = tw_level_cdb(t.slow, 0) * 0.01;
+  double li = tw_level_cdb(t.impulse_hold, 0) * 0.01;
+  if (verbose)
+    printf("  continuo %.2f dB: F %+.2f  S %+.2f  I %+.2f\n", steady, lf - steady, ls - steady, li - steady);
+  check(fabs(lf - steady) <= 0.1 && fabs(ls - steady) <= 0.1 && fabs(li - steady) <= 0.1, "tom continuo: F, S e I no nivel do tom");
+
+  // Trens de tom: duração (ms) e detectores com referência tabelada
+  const double burst_ms[] = {1000, 500, 200, 100, 50, 20, 10, 5, 2, 1, 0.5, 0.25};
+  const double tau_f = 0.125, tau_s = 1.0, tau_i = 0.035;
+  int burst_fails = 0;
+  double worst = 0.0;
+  for (double ms : burst_ms)
+  {
+    uint32_t len = (uint32_t)lround(ms * FS / 1000.0);
+    double f_db, s_db, i_db;
+    burst_max(len, &f_db, &s_db, &i_db);
+    double ref_f = 10.0 * log10(1.0 - exp(-ms / 1000.0 / tau_f));
+    double ref_s = 10.0 * log10(1.0 - exp(-ms / 1000.0 / tau_s));
+    double ref_i = 10.0 * log10(1.0 - exp(-ms / 1000.0 / tau_i));
+    double dev[3] = {f_db - steady - ref_f, s_db - steady - ref_s, i_db - steady - ref_i};
+    bool ok = true;
+    for (int d = 0; d < 3; d++)
+    {
+      ok &= fabs(dev[d]) <= 0.1;
+      worst = fabs(dev[d]) > fabs(worst) ? dev[d] : worst;
+    }
+    if (verbose || !ok)
+      printf("  %7.2f ms  F %+6.2f (%+.2f)  S %+6.2f (%+.2f)  I %+6.2f (%+.2f)%s\n", ms, f_db - steady, ref_f,
+             s_db - steady, ref_s, i_db - steady, ref_i, ok ? "" : "  FALHOU");
+    burst_fails += !ok;
+  }
+  char what[64];
+  snprintf(what, sizeof(what), "trens de tom F/S/I (maior desvio %+.2f dB)", worst);
+  check(burst_fails == 0, what);
+
+  // LCpeak: referência e tolerância de classe 1
+  double one_cycle = peak_minus_level(8000.0, FS / 8000, 1.0);
+  double positive = peak_minus_level(500.0, FS / 1000, 1.0);
+  double negative = peak_minus_level(500.0, FS / 1000, -1.0);
+  if (verbose)
+    printf("  LCpeak - LC: 1 ciclo 8 kHz %.2f, meio ciclo 500 Hz +%.2f / -%.2f dB\n", one_cycle, positive, negative);
+  check(fabs(one_cycle - 3.4) <= 2.4, "LCpeak de um ciclo de 8 kHz (3.4 +- 2.4 dB)");
+  check(fabs(positive - 2.4) <= 1.0, "LCpeak de meio ciclo positivo de 500 Hz");
+  check(fabs(negative - 2.4) <= 1.0, "LCpeak de meio ciclo negativo de 500 Hz");
+
+  printf(failures ? "FALHOU\n" : "OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+// Teste dos filtros de ponderação de weighting.h contra a IEC 61672-1 (roda no host).
+//
+// Para cada curva (A, C e Z) e cada frequência de terço de oitava (base dez, de
+// 10 Hz a 12.5 kHz), um tom de 1000 contagens passa pelo filtro em ponto fixo,
+// como no firmware, e o ganho medido é comparado com a curva de projeto da norma.
+// O desvio precisa ficar dentro das tolerâncias de classe 2 da tabela 3. 16 kHz
+// fica de fora: a 32 kHz é praticamente Nyquist, onde os zeros em z = -1 da
+// bilinear anulam a resposta.
+//
+// Compilação e uso:
+//   g++ -std=c++17 -O2 -I. tools/weighting_test.cpp -o weighting_test   (na raiz)
+//   ./weighting_test [-v]
+// Sai com código 1 se alguma frequência ficar fora da tolerância.
+
+#include <stdio.h>
+#include <string.h>
+
+#define MIC_SAMPLE_RATE_HZ 32000
+#include "weighting.h"
+
+static int failures = 0;
+
+// Tolerâncias de classe 2 (dB) da IEC 61672-1:2013, tabela 3; lower < -90 = sem limite
+typedef struct
+{
+  int index;  // Frequência 1000 * 10^(index / 10) Hz
+  double upper;
+  double lower;
+} Tolerance;
+
+static const Tolerance class2[] = {
+    {-20, 5.0, -99.0}, {-19, 5.0, -99.0}, {-18, 5.0, -99.0}, {-17, 3.0, -3.0},
+    {-16, 3.0, -3.0}, {-15, 3.0, -3.0}, {-14, 2.0, -2.0}, {-13, 2.0, -2.0},
+    {-12, 2.0, -2.0}, {-11, 2.0, -2.0}, {-10, 1.5, -1.5}, {-9, 1.5, -1.5},
+    {-8, 1.5, -1.5}, {-7, 1.5, -1.5}, {-6, 1.4, -1.4}, {-5, 1.4, -1.4},
+    {-4, 1.4, -1.4}, {-3, 1.4, -1.4}, {-2, 1.4, -1.4}, {-1, 1.4, -1.4},
+    {0, 1.0, -1.0}, {1, 1.4, -1.4}, {2, 1.6, -1.6}, {3, 1.6, -1.6},
+    {4, 1.6, -1.6}, {5, 1.6, -1.6}, {6, 1.6, -1.6}, {7, 2.1, -2.1},
+    {8, 2.1, -2.6}, {9, 2.1, -3.1}, {10, 2.6, -3.6}, {11, 3.0, -6.0},
+};
+
+// Curva de projeto da norma (dB), sem a normalização em 1 kHz
+static double design_raw(Weighting type, double f)
+{
+  const double f1 = WEIGHTING_F1 * WEIGHTING_F1, f2 = WEIGHTING_F2 * WEIGHTING_F2;
+  const double f3 = WEIGHTING_F3 * WEIGHTING_F3, f4 = WEIGHTING_F4 * WEIGHTING_F4;
+  double ff = f * f;
+  double c = f4 * ff / ((ff + f1) * (ff + f4));
+  switch (type)
+  {
+  case WEIGHT_A:
+    return 20.0 * log10(c * ff / sqrt((ff + f2) * (ff + f3)));
+  case WEIGHT_C:
+    return 20.0 * log10(c);
+  default:
+    return 0.0;
+  }
+}
+
+static double design_db(Weighting type, double f)
+{
+  return design_raw(type, f) - design_raw(type, 1000.0);
+}
+
+// Ganho do filtro em ponto fixo para um tom de f Hz (dB): 2 s de acomodação e 2 s de medida
+static double measured_db(Weighting type, double f)
+{
+  WeightingFilter filter;
+  weighting_init(&filter, type, MIC_SAMPLE_RATE_HZ);
+  const uint32_t settle = 2 * MIC_SAMPLE_RATE_HZ, measure = 2 * MIC_SAMPLE_RATE_HZ;
+  double in = 0.0, out = 0.0;
+  for (uint32_t n = 0; n < settle + measure; n++)
+  {
+    double counts = 1000.0 * sin(2.0 * M_PI * fmod(f * n / MIC_SAMPLE_RATE_HZ, 1.0));
+    int32_t x = (int32_t)lround(counts * (1 << WEIGHTING_INPUT_SHIFT));
+    int32_t y = weighting_run(&filter, x);
+    if (n >= settle)
+    {
+      in += (double)x * x;
+      out += (double)y * y;
+    }
+  }
+  return 10.0 * log10(out / in);
+}
+
+int main(int argc, char **argv)
+{
+  bool verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+  const Weighting types[] = {WEIGHT_A, WEIGHT_C, WEIGHT_Z};
+
+  for (Weighting type : types)
+  {
+    double worst = 0.0;
+    int fails = 0;
+    for (const Tolerance &t : class2)
+    {
+      double f = 1000.0 * pow(10.0, t.index / 10.0);
+      double dev = measured_db(type, f) - design_db(type, f);
+      bool ok = dev <= t.upper && (t.lower < -90.0 || dev >= t.lower);
+      if (verbose || !ok)
+        printf("  %c %8.1f Hz  desvio %+6.2f dB  (%+.1f / %+.1f)%s\n", weighting_letter(type), f, dev, t.upper,
+               t.lower < -90.0 ? -INFINITY : t.lower, ok ? "" : "  FALHOU");
+      if (fabs(dev) > fabs(worst) && (t.lower >= -90.0 || dev > 0.0))
+        worst = dev;
+      fails += !ok;
+    }
+    printf("%c: maior desvio com limite dos dois lados %+.2f dB  %s\n", weighting_letter(type), worst,
+           fails ? "FALHOU" : "ok");
+    failures += fails;
+  }
+
+  printf(failures ? "FALHOU\n" : "OK\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,143 @@
+// Filtros de ponderação em frequência A, C e Z (IEC 61672-1) em ponto fixo.
+//
+// O RP2040 não tem FPU, então os coeficientes são calculados uma única vez em
+// weighting_init() (ponto flutuante) e o filtro roda amostra a amostra só com
+// inteiros. Cada curva é uma cascata de biquads obtida pela transformação
+// bilinear dos polos analógicos da norma; todos os zeros ficam em z = 1 ou z = -1,
+// então o numerador de cada seção é g * (1 +- z^-1)^2 e custa uma multiplicação.
+//
+// Custo por amostra (A): 3 seções x 3 multiplicações 32x32->64, cerca de 400 ciclos
+// no Cortex-M0+, ~10% dos 3900 ciclos disponíveis por amostra a 125 MHz / 32 kHz.
+//
+// Desvio das curvas A e C em relação à norma a 32 kHz (com WEIGHTING_HF_POLE_SCALE =
+// 1.5): <= 0.1 dB até 2 kHz, +0.4 dB em 4 kHz, +0.8 dB em 6.3 e 8 kHz, -0.1 dB em
+// 10 kHz e -4.8 dB em 12.5 kHz, dentro das tolerâncias de classe 2 (e de classe 1) da
+// IEC 61672-1 de 10 Hz a 12.5 kHz. tools/weighting_test.cpp confere a classe 2.
+
+#include <stdint.h>
+#include <math.h>
+
+typedef enum
+{
+  WEIGHT_A = 0,
+  WEIGHT_C,
+  WEIGHT_Z,
+  WEIGHT_COUNT
+} Weighting;
+
+// Polos analógicos da IEC 61672-1 (Hz)
+#define WEIGHTING_F1 20.598997
+#define WEIGHTING_F2 107.65265
+#define WEIGHTING_F3 737.86223
+#define WEIGHTING_F4 12194.217
+
+// A bilinear comprime a região perto de Nyquist e derruba a resposta acima de 6 kHz.
+// Deslocar o polo duplo de 12.2 kHz compensa a queda; o valor padrão foi ajustado
+// para 32 kHz, e outra taxa precisa definir o seu (conferido com weighting_test).
+#ifndef WEIGHTING_HF_POLE_SCALE
+#define WEIGHTING_HF_POLE_SCALE 1.5
+static_assert(MIC_SAMPLE_RATE_HZ == 32000, "WEIGHTING_HF_POLE_SCALE ajustado para 32 kHz");
+#endif
+
+#define WEIGHTING_COEF_SHIFT 29 // Coeficientes em Q29 (faixa +-4)
+#define WEIGHTING_MAX_SECTIONS 3
+
+// Entrada do filtro: contagens do ADC em Q12 (amostra de 12 bits com sinal -> até 2^23)
+#define WEIGHTING_INPUT_SHIFT 12
+
+typedef struct
+{
+  int32_t g;    // Ganho do numerador (Q29)
+  int32_t a1;   // Coeficientes do denominador (Q29)
+  int32_t a2;
+  int8_t zero;  // +1: zeros duplos em z = -1 (passa-baixas); -1: em z = 1 (passa-altas)
+  int32_t x1, x2, y1, y2;
+  int32_t err;  // Resto do arredondamento realimentado na próxima amostra
+} WeightingSection;
+
+typedef struct
+{
+  Weighting type;
+  uint8_t num_sections;
+  WeightingSection sec[WEIGHTING_MAX_SECTIONS];
+} WeightingFilter;
+
+// Projeta uma seção com polos reais em wa e wb (rad/s), normalizada para ganho 1 em 1 kHz
+static void weighting_design_section(WeightingSection *s, double wa, double wb, int8_t zero, double fs)
+{
+  double k = 2.0 * fs;
+  double pa = (k - wa) / (k + wa);
+  double pb = (k - wb) / (k + wb);
+  double a1 = -(pa + pb);
+  double a2 = pa * pb;
+
+  double w = 2.0 * M_PI * 1000.0 / fs;
+  double num = 2.0 + 2.0 * zero * cos(w); // |1 + zero e^-jw|^2
+  double den_re = 1.0 + a1 * cos(w) + a2 * cos(2.0 * w);
+  double den_im = a1 * sin(w) + a2 * sin(2.0 * w);
+  double g = sqrt(den_re * den_re + den_im * den_im) / num;
+
+  const double one = (double)(1 << WEIGHTING_COEF_SHIFT);
+  s->g = (int32_t)lround(g * one);
+  s->a1 = (int32_t)lround(a1 * one);
+  s->a2 = (int32_t)lround(a2 * one);
+  s->zero = zero;
+  s->x1 = s->x2 = s->y1 = s->y2 = s->err = 0;
+}
+
+// Configura o filtro para a curva e a taxa de amostragem dadas
+void weighting_init(WeightingFilter *f, Weighting type, uint32_t sample_rate)
+{
+  const double w1 = 2.0 * M_PI * WEIGHTING_F1;
+  const double w2 = 2.0 * M_PI * WEIGHTING_F2;
+  const double w3 = 2.0 * M_PI * WEIGHTING_F3;
+  const double w4 = 2.0 * M_PI * WEIGHTING_F4 * WEIGHTING_HF_POLE_SCALE;
+  const double fs = sample_rate;
+
+  f->type = type;
+  switch (type)
+  {
+  case WEIGHT_A:
+    f->num_sections = 3;
+    weighting_design_section(&f->sec[0], w1, w1, -1, fs);
+    weighting_design_section(&f->sec[1], w2, w3, -1, fs);
+    weighting_design_section(&f->sec[2], w4, w4, +1, fs);
+    break;
+  case WEIGHT_C:
+    f->num_sections = 2;
+    weighting_design_section(&f->sec[0], w1, w1, -1, fs);
+    weighting_design_section(&f->sec[1], w4, w4, +1, fs);
+    break;
+  default:
+    f->type = WEIGHT_Z;
+    f->num_sections = 0;
+    break;
+  }
+}
+
+static inline int32_t weighting_section_run(WeightingSection *s, int32_t x)
+{
+  int32_t num = s->zero > 0 ? x + 2 * s->x1 + s->x2 : x - 2 * s->x1 + s->x2;
+  int64_t acc = (int64_t)s->g * num - (int64_t)s->a1 * s->y1 - (int64_t)s->a2 * s->y2 + s->err;
+  int32_t y = (int32_t)(acc >> WEIGHTING_COEF_SHIFT);
+  s->err = (int32_t)(acc - ((int64_t)y << WEIGHTING_COEF_SHIFT));
+
+  s->x2 = s->x1;
+  s->x1 = x;
+  s->y2 = s->y1;
+  s->y1 = y;
+  return y;
+}
+
+// Filtra uma amostra (contagens em Q12, ver WEIGHTING_INPUT_SHIFT)
+static inline int32_t weighting_run(WeightingFilter *f, int32_t x)
+{
+  for (uint8_t i = 0; i < f->num_sections; i++)
+    x = weighting_section_run(&f->sec[i], x);
+  return x;
+}
+
+static inline char weighting_letter(Weighting type)
+{
+  return type == WEIGHT_A ? 'A' : type == WEIGHT_C ? 'C' : 'Z';
+}